@@ -28,12 +28,34 @@
 
 (require 'easymenu)
 (require 'ledger-navigate)
+(require 'ledger-regex)
+(require 'ledger-complete) ; for ledger-accounts-in-buffer
 (require 'ledger-report) ; for ledger-master-file
 
 
 (defvar ledger-check-buffer-name "*Ledger Check*")
 (defvar ledger-original-window-cfg nil)
 
+(defcustom ledger-check-incremental nil
+  "If non-nil, check only the transactions edited since the last clean check.
+Edited transactions are validated against the account names
+already known to the buffer instead of re-parsing the whole
+journal.  A full run still happens when no clean check has
+completed yet, or when a top-level directive or include was
+edited, since those can change the set of valid accounts."
+  :type 'boolean
+  :package-version '(ledger-mode . "4.0.1")
+  :group 'ledger)
+
+(defvar-local ledger-check--dirty-regions nil
+  "Marker pairs for buffer text edited since the last clean full check.
+Only maintained after a full check has completed without
+warnings; nil also means a full check is required.  Incremental
+passes never clear this list, since they only vet account names.")
+
+(defvar-local ledger-check--tracking nil
+  "Non-nil once edits are being tracked for incremental checks.")
+
 
 
 
@@ -57,24 +79,16 @@
 (define-derived-mode ledger-check-mode text-mode "Ledger-Check"
   "A mode for viewing ledger errors and warnings.")
 
+;; To silence byte compiler warnings, `ledger-check--declared-accounts'
+;; binds this variable defined in ledger-flymake.el:
+(defvar ledger-flymake-be-pedantic)
 
-(defun ledger-do-check ()
-  "Run a check command ."
-  (goto-char (point-min))
-  (let ((data-pos (point))
-        (have-warnings nil))
-    (shell-command
-     ;;  ledger balance command will just return empty if you give it
-     ;;  an account name that doesn't exist.  I will assume that no
-     ;;  one will ever have an account named "e342asd2131".  If
-     ;;  someones does, this will probably still work for them.
-     ;;  I should only highlight error and warning lines.
-     "ledger bal e342asd2131 --strict --explicit "
-     t nil)
-    (goto-char data-pos)
-
-    ;; format check report to make it navigate the file
 
+(defun ledger-check--format-output (data-pos)
+  "Make error and warning lines after DATA-POS navigate to their source.
+Return non-nil if any such lines were found."
+  (goto-char data-pos)
+  (let ((have-warnings nil))
     (while (re-search-forward "^.*: \"\\(.*\\)\", line \\([0-9]+\\)" nil t)
       (let ((file (match-string 1))
             (line (string-to-number (match-string 2))))
@@ -90,8 +104,105 @@
                                (list 'font-lock-face 'ledger-font-report-clickable-face))
           (setq have-warnings 'true)
           (end-of-line))))
+    have-warnings))
+
+(defun ledger-do-check ()
+  "Run a check command.
+Return non-nil if any errors or warnings were reported."
+  (goto-char (point-min))
+  (let ((data-pos (point))
+        (have-warnings nil))
+    (shell-command
+     ;;  ledger balance command will just return empty if you give it
+     ;;  an account name that doesn't exist.  I will assume that no
+     ;;  one will ever have an account named "e342asd2131".  If
+     ;;  someones does, this will probably still work for them.
+     ;;  I should only highlight error and warning lines.
+     "ledger bal e342asd2131 --strict --explicit "
+     t nil)
+
+    ;; format check report to make it navigate the file
+
+    (setq have-warnings (ledger-check--format-output data-pos))
     (if (not have-warnings)
-        (insert "No errors or warnings reported."))))
+        (insert "No errors or warnings reported."))
+    have-warnings))
+
+(defun ledger-do-incremental-check (diagnostics)
+  "Insert DIAGNOSTICS into the check buffer and make them navigable.
+Return non-nil if DIAGNOSTICS is non-empty."
+  (goto-char (point-min))
+  (let ((data-pos (point))
+        (have-warnings nil))
+    (dolist (line diagnostics)
+      (insert line "\n"))
+    (setq have-warnings (ledger-check--format-output data-pos))
+    (if (not have-warnings)
+        (insert "No errors or warnings reported."))
+    have-warnings))
+
+(defun ledger-check--track-change (beg end _len)
+  "Record the region from BEG to END as dirty for incremental checks."
+  (when ledger-check--tracking
+    (push (cons (copy-marker beg) (copy-marker end))
+          ledger-check--dirty-regions)))
+
+(defun ledger-check--mark-clean ()
+  "Restart edit tracking from a journal that just checked clean."
+  (dolist (region ledger-check--dirty-regions)
+    (set-marker (car region) nil)
+    (set-marker (cdr region) nil))
+  (setq ledger-check--dirty-regions nil)
+  (unless ledger-check--tracking
+    (setq ledger-check--tracking t)
+    (add-hook 'after-change-functions #'ledger-check--track-change nil t)))
+
+(defun ledger-check--dirty-xact-spans ()
+  "Return merged extents of the xacts touched since the last clean check.
+Return the symbol `full' when an edit touched a top-level
+directive, which may change the set of valid account names."
+  (catch 'full
+    (let (spans)
+      (dolist (region ledger-check--dirty-regions)
+        (let* ((beg (min (marker-position (car region)) (point-max)))
+               (end (max beg (min (marker-position (cdr region)) (point-max))))
+               (span (list (car (ledger-navigate-find-xact-extents beg))
+                           (cadr (ledger-navigate-find-xact-extents end)))))
+          (save-excursion
+            (goto-char (car span))
+            (beginning-of-line)
+            (while (< (point) (cadr span))
+              (unless (looking-at-p "[ \t]\\|$\\|[0-9=~;#%|*]")
+                (throw 'full 'full))
+              (forward-line)))
+          (push span spans)))
+      (setq spans (sort spans (lambda (a b) (< (car a) (car b)))))
+      (let (merged)
+        (dolist (span spans)
+          (if (and merged (<= (car span) (cadr (car merged))))
+              (setcar (cdr (car merged))
+                      (max (cadr span) (cadr (car merged))))
+            (push (list (car span) (cadr span)) merged)))
+        (nreverse merged)))))
+
+(defun ledger-check--unknown-accounts (spans)
+  "Return warning lines for postings in SPANS with undeclared accounts.
+The reference set is the accounts declared with account
+directives, matching what ledger itself accepts under --strict."
+  (let ((known (let ((ledger-flymake-be-pedantic t))
+                 (ledger-accounts-in-buffer)))
+        (file (or (buffer-file-name) (buffer-name)))
+        diags)
+    (dolist (span spans)
+      (save-excursion
+        (goto-char (car span))
+        (while (re-search-forward ledger-account-any-status-regex (cadr span) t)
+          (let ((account (match-string-no-properties 1)))
+            (unless (assoc account known)
+              (push (format "Warning: \"%s\", line %d: Unknown account '%s'"
+                            file (line-number-at-pos) account)
+                    diags))))))
+    (nreverse diags)))
 
 (defun ledger-check-goto ()
   "Goto the ledger check buffer."
@@ -116,26 +227,50 @@ Runs ledger with --explicit and --strict report errors and assist
 with fixing them.
 
 The output buffer will be in `ledger-check-mode', which defines
-commands for navigating the buffer to the errors found, etc."
+commands for navigating the buffer to the errors found, etc.
+
+When `ledger-check-incremental' is non-nil and a previous check
+came back clean, only the transactions edited since then are
+validated; see that option for the cases that still force a full
+run."
   (interactive
    (progn
      (when (and (buffer-modified-p)
                 (y-or-n-p "Buffer modified, save it? "))
        (save-buffer))))
-  (let ((_buf (find-file-noselect (ledger-master-file)))
-        (cbuf (get-buffer ledger-check-buffer-name))
-        (wcfg (current-window-configuration)))
+  (let* ((_buf (find-file-noselect (ledger-master-file)))
+         (cbuf (get-buffer ledger-check-buffer-name))
+         (wcfg (current-window-configuration))
+         (src (current-buffer))
+         (spans (and ledger-check-incremental
+                     ledger-check--tracking
+                     (ledger-check--dirty-xact-spans)))
+         (incremental (and ledger-check-incremental
+                           ledger-check--tracking
+                           (not (eq spans 'full))))
+         (diagnostics (and incremental (ledger-check--unknown-accounts spans)))
+         (have-warnings nil))
     (if cbuf
         (kill-buffer cbuf))
     (with-current-buffer
         (pop-to-buffer (get-buffer-create ledger-check-buffer-name))
       (ledger-check-mode)
       (set (make-local-variable 'ledger-original-window-cfg) wcfg)
-      (ledger-do-check)
+      (setq have-warnings
+            (if incremental
+                (ledger-do-incremental-check diagnostics)
+              (ledger-do-check)))
       (shrink-window-if-larger-than-buffer)
       (set-buffer-modified-p nil)
       (setq buffer-read-only t)
-      (message "q to quit; r to redo; k to kill"))))
+      (message "q to quit; r to redo; k to kill"))
+    ;; Only a full run proves the journal clean.  An incremental pass
+    ;; validates account names alone, so a warning-free result must not
+    ;; retire the dirty spans: an edit that unbalanced a transaction
+    ;; without touching an account would otherwise never be re-checked.
+    (unless (or have-warnings incremental)
+      (with-current-buffer src
+        (ledger-check--mark-clean)))))
 
 
 (provide 'ledger-check)
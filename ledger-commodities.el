@@ -48,9 +48,46 @@ Default value is `ledger-reconcile-default-commodity'."
                         (split-string (buffer-string) "\n" t))))
     (completing-read prompt commodities nil t nil nil ledger-reconcile-default-commodity)))
 
+(defvar ledger-commodities--parse-cache (make-hash-table :test #'equal :size 512)
+  "Cache mapping raw amount strings to parsed (VALUE COMMODITY) cells.")
+
+(defvar ledger-commodities--parse-cache-decimal-comma 'unset
+  "Decimal-comma setting `ledger-commodities--parse-cache' was filled under.")
+
+(defconst ledger-commodities--parse-cache-size 4096
+  "Number of entries allowed in the parse cache before it is flushed.")
+
+(defvar ledger-commodities--names (make-hash-table :test #'equal :size 16)
+  "Table interning commodity name strings, so equal names are also `eq'.")
+
+(defun ledger-commodities--intern-name (name)
+  "Return the canonical string for commodity NAME, interning it if new."
+  (and name
+       (or (gethash name ledger-commodities--names)
+           (puthash name name ledger-commodities--names))))
+
 (defun ledger-split-commodity-string (str)
   "Split a commoditized string, STR, into two parts.
-Returns a list with (value commodity)."
+Returns a list with (value commodity).  Results are memoized, and
+the same STR returns the same cell, so callers must not mutate
+the returned list."
+  (let ((decimal-comma (and (assoc "decimal-comma" ledger-environment-alist) t)))
+    ;; the parse depends on the decimal separator, so a cache filled
+    ;; under the other setting is useless
+    (unless (eq decimal-comma ledger-commodities--parse-cache-decimal-comma)
+      (clrhash ledger-commodities--parse-cache)
+      (setq ledger-commodities--parse-cache-decimal-comma decimal-comma))
+    (or (gethash str ledger-commodities--parse-cache)
+        (progn
+          (when (> (hash-table-count ledger-commodities--parse-cache)
+                   ledger-commodities--parse-cache-size)
+            (clrhash ledger-commodities--parse-cache))
+          (puthash str (ledger-commodities--split-commodity-string str)
+                   ledger-commodities--parse-cache)))))
+
+(defun ledger-commodities--split-commodity-string (str)
+  "Parse the commoditized string STR into a (value commodity) list.
+This is the uncached worker behind `ledger-split-commodity-string'."
   (let ((number-regex (if (assoc "decimal-comma" ledger-environment-alist)
                           ledger-amount-decimal-comma-regex
                         ledger-amount-decimal-period-regex)))
@@ -68,7 +105,7 @@ Returns a list with (value commodity)."
                   (list
                    (ledger-string-to-number
                     (delete-and-extract-region (match-beginning 0) (match-end 0)))
-                   com))))
+                   (ledger-commodities--intern-name com)))))
            ((re-search-forward number-regex nil t)
             ;; found a number in the current locale, return it in the
             ;; car.  Anything left over is annotation, the first
@@ -78,7 +115,8 @@ Returns a list with (value commodity)."
             (list
              (ledger-string-to-number
               (delete-and-extract-region (match-beginning 0) (match-end 0)))
-             (nth 0 (split-string (buffer-substring-no-properties (point-min) (point-max))))))
+             (ledger-commodities--intern-name
+              (nth 0 (split-string (buffer-substring-no-properties (point-min) (point-max)))))))
            ((re-search-forward "0" nil t)
             ;; couldn't find a decimal number, look for a single 0,
             ;; indicating account with zero balance
@@ -95,15 +133,21 @@ Returns a list with (value commodity)."
 
 (defun ledger-subtract-commodity (c1 c2)
   "Subtract C2 from C1, ensuring their commodities match."
-  (if (string= (cadr c1) (cadr c2))
-      (list (-(car c1) (car c2)) (cadr c1))
-    (error "Can't subtract different commodities %S from %S" c2 c1)))
+  (let ((com1 (cadr c1))
+        (com2 (cadr c2)))
+    ;; interned commodity names are `eq', sparing the string compare
+    ;; in single-commodity balance loops
+    (if (or (eq com1 com2) (string= com1 com2))
+        (list (- (car c1) (car c2)) com1)
+      (error "Can't subtract different commodities %S from %S" c2 c1))))
 
 (defun ledger-add-commodity (c1 c2)
   "Add C1 and C2, ensuring their commodities match."
-  (if (string= (cadr c1) (cadr c2))
-      (list (+ (car c1) (car c2)) (cadr c1))
-    (error "Can't add different commodities, %S to %S" c1 c2)))
+  (let ((com1 (cadr c1))
+        (com2 (cadr c2)))
+    (if (or (eq com1 com2) (string= com1 com2))
+        (list (+ (car c1) (car c2)) com1)
+      (error "Can't add different commodities, %S to %S" c1 c2))))
 
 (defun ledger-strip (str char)
   "Return STR with CHAR removed."
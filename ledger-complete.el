@@ -32,6 +32,7 @@
 (require 'ledger-context)
 (require 'ledger-xact)
 (require 'ledger-schedule)
+(declare-function ledger-master-file "ledger-report" ())
 
 (defcustom ledger-accounts-file nil
   "The path to an optional file in which all accounts are used or declared.
@@ -85,49 +86,124 @@ If nil, full account names are offered for completion."
       (cons (reverse args) (reverse begins)))))
 
 
-(defun ledger-payees-in-buffer ()
-  "Scan buffer and return list of all payees."
-  (let ((origin (point))
-        payees-list)
-    (save-excursion
-      (goto-char (point-min))
-      (while (re-search-forward
-              ledger-payee-any-status-regex nil t)  ;; matches first line
-        (unless (and (>= origin (match-beginning 0))
-                     (< origin (match-end 0)))
-          (setq payees-list (cons (match-string-no-properties 3)
-                                  payees-list)))))  ;; add the payee
-    ;; to the list
-    (sort (delete-dups payees-list) #'string-lessp)))
+;;; Incremental account and payee index
 
-(defun ledger-accounts-in-buffer ()
-  "Return an alist of accounts in the current buffer.
-The `car' of each element is the account name and the `cdr' is an
-alist where the key is a subdirective such as \"assert\" and the
-value (if any) is the associated data.  In other words, if you've
-declared an account like so:
+;; Rather than rescanning the whole buffer on every completion request
+;; (which becomes very slow on large journals), completion names are kept
+;; in per-buffer hash tables that are built once and then maintained from
+;; the change hooks, touching only the region around each edit.
 
-account Assets:Checking
-    assert commodity == \"$\"
-    default
+(defvar-local ledger-complete--payee-index nil
+  "Hash table mapping payee names to their occurrence count, or nil.
+Nil means the index has not been built for this buffer yet.")
 
-Then one of the elements this function returns will be
-\(\"Assets:Checking\"
-  (\"default\")
-  (\"assert\" . \"commodity == \"$\"\"))"
+(defvar-local ledger-complete--account-index nil
+  "Hash table mapping account names to index entries, or nil.
+Each entry is a vector [POSTING-COUNT DIRECTIVE-COUNT DATA] where
+DATA is the subdirective alist of the most recently indexed
+\"account\" directive, as described in `ledger-accounts-in-buffer'.")
+
+(defvar-local ledger-complete--index-tick nil
+  "Value of `buffer-chars-modified-tick' when the index was last updated.
+Used to detect modifications that bypassed the change hooks, in
+which case the index is rebuilt from scratch.")
+
+(defvar-local ledger-complete--payee-last-pos nil
+  "Hash table mapping payee names to a marker at their last indexed xact.
+Lets `ledger-fully-complete-xact' jump straight to a donor
+transaction instead of searching the whole buffer backward.
+Entries are re-verified at lookup time, so a stale marker only
+costs a fallback to the old search.")
+
+(defvar-local ledger-complete--payee-accounts nil
+  "Hash table mapping payee names to account frequency tables.
+Each value is a hash table from account name to the number of
+postings under that payee, maintained by the incremental index,
+so account completion can offer a payee's historical accounts
+first without scanning the buffer.")
+
+(defun ledger-complete--index-extend-region (beg end)
+  "Widen the region BEG..END to whole transactions and directives.
+The region is grown to start and end on lines at column zero, so
+that multi-line elements such as \"account\" directives with
+subdirective lines are always indexed as a unit.  Return the
+widened region as a cons (BEG . END)."
   (save-excursion
-    (goto-char (point-min))
-    (let (account-list
-          (seen (make-hash-table :test #'equal :size 1)))
-      ;; First, consider accounts declared with "account" directives, which may or
-      ;; may not have associated data. The data is on the following lines up to a
-      ;; line not starting with whitespace.
-      (while (re-search-forward ledger-account-directive-regex nil t)
+    (goto-char beg)
+    (forward-line 0)
+    (while (and (not (bobp)) (looking-at-p "[ \t]\\|$"))
+      (forward-line -1))
+    (setq beg (point))
+    (goto-char end)
+    (forward-line 1)
+    (while (and (not (eobp)) (looking-at-p "[ \t]\\|$"))
+      (forward-line 1))
+    (cons beg (point))))
+
+(defun ledger-complete--index-update-account (account posting-delta directive-delta data)
+  "Apply POSTING-DELTA and DIRECTIVE-DELTA to the entry for ACCOUNT.
+DATA replaces the stored subdirective alist when a directive is
+being added.  Entries whose counts drop to zero are removed."
+  (let ((entry (or (gethash account ledger-complete--account-index)
+                   (vector 0 0 nil))))
+    (aset entry 0 (+ (aref entry 0) posting-delta))
+    (aset entry 1 (+ (aref entry 1) directive-delta))
+    (if (and (<= (aref entry 0) 0) (<= (aref entry 1) 0))
+        (remhash account ledger-complete--account-index)
+      (when (> directive-delta 0)
+        (aset entry 2 data))
+      (when (<= (aref entry 1) 0)
+        (aset entry 2 nil))
+      (puthash account entry ledger-complete--account-index))))
+
+(defun ledger-complete--index-scan (beg end delta)
+  "Add DELTA to the indexed occurrence counts of names between BEG and END.
+DELTA is 1 when text is being indexed and -1 when it is about to
+be removed or rewritten."
+  (save-excursion
+    (save-match-data
+      (goto-char beg)
+      (while (re-search-forward ledger-payee-any-status-regex end t)
+        (let* ((payee (match-string-no-properties 3))
+               (count (+ delta (gethash payee ledger-complete--payee-index 0))))
+          (if (> count 0)
+              (puthash payee count ledger-complete--payee-index)
+            (remhash payee ledger-complete--payee-index))
+          (when (and (> delta 0) ledger-complete--payee-last-pos)
+            (let ((marker (gethash payee ledger-complete--payee-last-pos)))
+              (if marker
+                  (set-marker marker (match-beginning 0))
+                (puthash payee (copy-marker (match-beginning 0))
+                         ledger-complete--payee-last-pos))))
+          (when ledger-complete--payee-accounts
+            (let ((table (or (gethash payee ledger-complete--payee-accounts)
+                             (puthash payee (make-hash-table :test #'equal)
+                                      ledger-complete--payee-accounts)))
+                  (xact-end (save-excursion
+                              (ledger-navigate-next-xact-or-directive)
+                              (min end (point)))))
+              (save-excursion
+                (while (re-search-forward ledger-account-any-status-regex xact-end t)
+                  (let* ((account (match-string-no-properties 1))
+                         (acount (+ delta (gethash account table 0))))
+                    (if (> acount 0)
+                        (puthash account acount table)
+                      (remhash account table)))))
+              (when (zerop (hash-table-count table))
+                (remhash payee ledger-complete--payee-accounts))))))
+      (goto-char beg)
+      (while (re-search-forward ledger-account-name-or-directive-regex end t)
+        (ledger-complete--index-update-account
+         (match-string-no-properties 1) delta 0 nil))
+      ;; Directives need a second pass because their subdirective data is on
+      ;; the following lines up to a line not starting with whitespace.
+      (goto-char beg)
+      (while (re-search-forward ledger-account-directive-regex end t)
         (let ((account (match-string-no-properties 1))
               (lines (buffer-substring-no-properties
                       (point)
                       (progn (ledger-navigate-next-xact-or-directive)
-                             (point))))
+                             (min end (point)))))
               data)
           (dolist (d (split-string lines "\n"))
             (setq d (string-trim d))
@@ -137,22 +213,357 @@ Then one of the elements this function returns will be
                               (substring d (match-end 0) nil))
                         data)
                 (push (cons d nil) data))))
-          (push (cons account data) account-list)
-          (puthash account t seen)))
-      ;; Next, gather all accounts declared in postings
-      (unless
-          ;; FIXME: People who have set `ledger-flymake-be-pedantic' to non-nil
-          ;; probably don't want accounts from postings, just those declared
-          ;; with directives.  But the name is a little misleading.  Should we
-          ;; make a ledger-mode-be-pedantic and use that instead?
-          (bound-and-true-p ledger-flymake-be-pedantic)
-        (goto-char (point-min))
-        (while (re-search-forward ledger-account-name-or-directive-regex nil t)
-          (let ((account (match-string-no-properties 1)))
-            (unless (gethash account seen)
-              (puthash account t seen)
-              (push (cons account nil) account-list)))))
-      (sort account-list (lambda (a b) (string-lessp (car a) (car b)))))))
+          (ledger-complete--index-update-account account 0 delta data))))))
+
+;;; Persistent completion cache
+;;
+;; Rebuilding the index costs a full buffer scan, which large journals
+;; pay again on every Emacs restart.  The index of each unmodified,
+;; file-visiting buffer is therefore mirrored to a cache file keyed by
+;; file name and modification time, so the first completion after
+;; startup restores it without scanning.
+
+(defcustom ledger-complete-cache-file
+  (locate-user-emacs-file "ledger-complete-cache.eld")
+  "File persisting completion indexes across sessions, nil to disable.
+Entries are keyed by journal file name and modification time, so
+a journal edited outside Emacs is simply re-scanned."
+  :type '(choice (const :tag "Do not persist completions" nil) file)
+  :group 'ledger
+  :package-version '(ledger-mode . "4.0.1"))
+
+(defvar ledger-complete--cache nil
+  "In-memory copy of `ledger-complete-cache-file'.
+An alist mapping journal file names to plists with :mtime,
+:payees and :accounts entries.")
+
+(defvar ledger-complete--cache-loaded nil
+  "Non-nil once `ledger-complete-cache-file' has been read.")
+
+(defun ledger-complete--file-mtime (file)
+  "Return the modification time of FILE."
+  (file-attribute-modification-time (file-attributes file)))
+
+(defun ledger-complete--cache-load ()
+  "Read `ledger-complete-cache-file' unless it has been read already."
+  (unless ledger-complete--cache-loaded
+    (setq ledger-complete--cache-loaded t)
+    (when (and ledger-complete-cache-file
+               (file-readable-p ledger-complete-cache-file))
+      (condition-case nil
+          (with-temp-buffer
+            (insert-file-contents ledger-complete-cache-file)
+            (setq ledger-complete--cache (read (current-buffer))))
+        (error (setq ledger-complete--cache nil))))))
+
+(defun ledger-complete--cache-save ()
+  "Write the in-memory completion cache to `ledger-complete-cache-file'."
+  (when ledger-complete-cache-file
+    (condition-case nil
+        (with-temp-file ledger-complete-cache-file
+          (let ((print-length nil)
+                (print-level nil))
+            (prin1 ledger-complete--cache (current-buffer))))
+      (error nil))))
+
+(defun ledger-complete--index-restore ()
+  "Restore the completion index from the persistent cache.
+Return non-nil when an up-to-date entry for the visited file was
+found and installed."
+  (let* ((file (buffer-file-name))
+         (entry (and file
+                     ledger-complete-cache-file
+                     (not noninteractive)
+                     (not (buffer-modified-p))
+                     (progn (ledger-complete--cache-load)
+                            (cdr (assoc (expand-file-name file)
+                                        ledger-complete--cache))))))
+    (when (and entry
+               (equal (plist-get entry :mtime)
+                      (ledger-complete--file-mtime file))
+               (hash-table-p (plist-get entry :payees))
+               (hash-table-p (plist-get entry :accounts)))
+      (setq ledger-complete--payee-index (copy-hash-table (plist-get entry :payees))
+            ledger-complete--account-index (copy-hash-table (plist-get entry :accounts)))
+      ;; older cache files have no :payee-accounts entry
+      (when (hash-table-p (plist-get entry :payee-accounts))
+        (setq ledger-complete--payee-accounts
+              (copy-hash-table (plist-get entry :payee-accounts))))
+      t)))
+
+(defun ledger-complete--index-persist ()
+  "Store the buffer's completion index in the persistent cache.
+Does nothing unless the buffer visits a file and has no unsaved
+modifications, since the cache entry is keyed by the file's
+modification time.  Batch sessions neither read nor write the
+cache; they are one-shot, so persisting across them is pointless."
+  (let ((file (buffer-file-name)))
+    (when (and file
+               ledger-complete-cache-file
+               (not noninteractive)
+               ledger-complete--payee-index
+               (not (buffer-modified-p)))
+      (ledger-complete--cache-load)
+      (let* ((key (expand-file-name file))
+             (value (list :mtime (ledger-complete--file-mtime file)
+                          :payees ledger-complete--payee-index
+                          :accounts ledger-complete--account-index
+                          :payee-accounts ledger-complete--payee-accounts))
+             (entry (assoc key ledger-complete--cache)))
+        (if entry
+            (setcdr entry value)
+          (push (cons key value) ledger-complete--cache)))
+      (ledger-complete--cache-save))))
+
+;;; Include-graph indexing
+;;
+;; A journal split across many "include" files only ever had its
+;; visiting buffer scanned, so names defined in other files never
+;; completed.  The include graph rooted at the master file is resolved
+;; here and each included file is indexed lazily by reading it into a
+;; temporary buffer — no file-visiting buffers are created — with
+;; per-file invalidation by modification time.
+
+(defcustom ledger-complete-scan-includes t
+  "When non-nil, completion also offers names from included files.
+The include graph is resolved from the master file (see
+`ledger-master-file') and each file is indexed lazily, off the
+visiting-buffer path, and re-indexed when it changes on disk."
+  :type 'boolean
+  :group 'ledger
+  :package-version '(ledger-mode . "4.0.1"))
+
+(defvar ledger-complete--file-index (make-hash-table :test #'equal)
+  "Hash table mapping file names to their completion index entries.
+Each entry is a plist with :mtime, :payees, :accounts and
+:includes keys, as built by `ledger-complete--scan-file'.")
+
+(defconst ledger-complete--include-regex
+  "^[ \t]*!?include[ \t]+\\(.*?\\)[ \t]*$"
+  "Regular expression matching include directives.")
+
+(defvar-local ledger-complete--buffer-includes nil
+  "Cons (TICK . FILES) caching the include directives of the buffer.")
+
+(defun ledger-complete--expand-include (pattern)
+  "Return the existing files matched by the include PATTERN.
+PATTERN is resolved against `default-directory' and may contain
+wildcards."
+  (ignore-errors (file-expand-wildcards pattern t)))
+
+(defun ledger-complete--buffer-includes ()
+  "Return the files included by the current buffer."
+  (let ((tick (buffer-chars-modified-tick)))
+    (unless (and ledger-complete--buffer-includes
+                 (eql (car ledger-complete--buffer-includes) tick))
+      (let (files)
+        (save-excursion
+          (save-match-data
+            (goto-char (point-min))
+            (while (re-search-forward ledger-complete--include-regex nil t)
+              (dolist (f (ledger-complete--expand-include
+                          (match-string-no-properties 1)))
+                (push f files)))))
+        (setq ledger-complete--buffer-includes (cons tick (nreverse files)))))
+    (cdr ledger-complete--buffer-includes)))
+
+(defun ledger-complete--scan-file (file)
+  "Read FILE into a temporary buffer and return its index entry."
+  (with-temp-buffer
+    (insert-file-contents file)
+    (setq ledger-complete--payee-index (make-hash-table :test #'equal)
+          ledger-complete--account-index (make-hash-table :test #'equal))
+    (ledger-complete--index-scan (point-min) (point-max) 1)
+    (let ((default-directory (file-name-directory file))
+          includes)
+      (goto-char (point-min))
+      (while (re-search-forward ledger-complete--include-regex nil t)
+        (dolist (f (ledger-complete--expand-include
+                    (match-string-no-properties 1)))
+          (push f includes)))
+      (list :mtime (ledger-complete--file-mtime file)
+            :payees ledger-complete--payee-index
+            :accounts ledger-complete--account-index
+            :includes (nreverse includes)))))
+
+(defun ledger-complete--file-entry (file)
+  "Return an up-to-date index entry for FILE, scanning it if needed.
+Return nil when FILE is not readable."
+  (setq file (expand-file-name file))
+  (let ((entry (gethash file ledger-complete--file-index)))
+    (unless (and entry
+                 (equal (plist-get entry :mtime)
+                        (ledger-complete--file-mtime file)))
+      (setq entry (and (file-readable-p file)
+                       (ledger-complete--scan-file file)))
+      (puthash file entry ledger-complete--file-index))
+    entry))
+
+(defun ledger-complete--include-entries ()
+  "Return index entries for the include graph of the current buffer.
+The graph is rooted at the master file and walked transitively;
+the file the current buffer visits is excluded, since the buffer
+itself is indexed incrementally."
+  (when (and ledger-complete-scan-includes
+             (fboundp 'ledger-master-file))
+    (let* ((self (and (buffer-file-name)
+                      (expand-file-name (buffer-file-name))))
+           (master (ignore-errors (ledger-master-file)))
+           (pending (and master (list (expand-file-name master))))
+           (seen (make-hash-table :test #'equal))
+           entries)
+      (while pending
+        (let ((file (pop pending)))
+          (unless (gethash file seen)
+            (puthash file t seen)
+            (if (equal file self)
+                (setq pending (append pending (ledger-complete--buffer-includes)))
+              (let ((entry (ledger-complete--file-entry file)))
+                (when entry
+                  (push entry entries)
+                  (setq pending (append pending (plist-get entry :includes)))))))))
+      entries)))
+
+(defun ledger-complete-journal-files ()
+  "Return the files making up the journal of the current buffer.
+The list starts with the master file and follows include
+directives transitively; all names are expanded."
+  (let* ((self (and (buffer-file-name)
+                    (expand-file-name (buffer-file-name))))
+         (master (and (fboundp 'ledger-master-file)
+                      (ignore-errors (ledger-master-file))))
+         (pending (if master
+                      (list (expand-file-name master))
+                    (and self (list self))))
+         (seen (make-hash-table :test #'equal))
+         files)
+    (while pending
+      (let ((file (pop pending)))
+        (unless (gethash file seen)
+          (puthash file t seen)
+          (push file files)
+          (if (equal file self)
+              (setq pending (append pending (ledger-complete--buffer-includes)))
+            (let ((entry (ledger-complete--file-entry file)))
+              (when entry
+                (setq pending (append pending
+                                      (plist-get entry :includes)))))))))
+    (nreverse files)))
+
+(defun ledger-complete--index-invalidate ()
+  "Drop the completion index; it will be rebuilt on the next lookup."
+  (setq ledger-complete--payee-index nil
+        ledger-complete--account-index nil
+        ledger-complete--payee-last-pos nil
+        ledger-complete--payee-accounts nil
+        ledger-complete--index-tick nil))
+
+(defun ledger-complete--index-before-change (beg end)
+  "Un-index the names in the region BEG..END before it is changed."
+  (when ledger-complete--payee-index
+    (condition-case nil
+        (let ((region (ledger-complete--index-extend-region beg end)))
+          (ledger-complete--index-scan (car region) (cdr region) -1))
+      (error (ledger-complete--index-invalidate)))))
+
+(defun ledger-complete--index-after-change (beg end _len)
+  "Index the names in the changed region BEG..END."
+  (when ledger-complete--payee-index
+    (condition-case nil
+        (let ((region (ledger-complete--index-extend-region beg end)))
+          (ledger-complete--index-scan (car region) (cdr region) 1)
+          (setq ledger-complete--index-tick (buffer-chars-modified-tick)))
+      (error (ledger-complete--index-invalidate)))))
+
+(defun ledger-complete--index-build ()
+  "Build the completion index for the current buffer.
+The persistent cache is consulted first; a full buffer scan only
+happens when no up-to-date cache entry exists."
+  (setq ledger-complete--payee-last-pos (make-hash-table :test #'equal)
+        ledger-complete--payee-accounts (make-hash-table :test #'equal))
+  (unless (ledger-complete--index-restore)
+    (setq ledger-complete--payee-index (make-hash-table :test #'equal)
+          ledger-complete--account-index (make-hash-table :test #'equal))
+    (ledger-complete--index-scan (point-min) (point-max) 1)
+    (ledger-complete--index-persist))
+  (setq ledger-complete--index-tick (buffer-chars-modified-tick))
+  (add-hook 'before-change-functions #'ledger-complete--index-before-change nil t)
+  (add-hook 'after-change-functions #'ledger-complete--index-after-change nil t)
+  (add-hook 'after-save-hook #'ledger-complete--index-persist nil t))
+
+(defun ledger-complete--index-ensure ()
+  "Build the completion index unless an up-to-date one exists."
+  (unless (and ledger-complete--payee-index
+               (eql ledger-complete--index-tick (buffer-chars-modified-tick)))
+    (ledger-complete--index-build)))
+
+(defun ledger-complete--payee-at-point ()
+  "Return the payee of the transaction header at point, if any.
+Point must be within the payee match on its line."
+  (save-excursion
+    (save-match-data
+      (let ((origin (point)))
+        (forward-line 0)
+        (when (and (looking-at ledger-payee-any-status-regex)
+                   (>= origin (match-beginning 0))
+                   (< origin (match-end 0)))
+          (match-string-no-properties 3))))))
+
+(defun ledger-payees-in-buffer ()
+  "Return a list of all payees in the buffer and its included files.
+The payee under point is excluded unless it also appears in
+another transaction, so that a half-typed payee does not complete
+to itself."
+  (ledger-complete--index-ensure)
+  (let ((at-point (ledger-complete--payee-at-point))
+        (merged (make-hash-table :test #'equal))
+        payees-list)
+    (maphash (lambda (payee count)
+               (unless (and (equal payee at-point) (= count 1))
+                 (puthash payee t merged)))
+             ledger-complete--payee-index)
+    (dolist (entry (ledger-complete--include-entries))
+      (maphash (lambda (payee _count) (puthash payee t merged))
+               (plist-get entry :payees)))
+    (maphash (lambda (payee _) (push payee payees-list)) merged)
+    (sort payees-list #'string-lessp)))
+
+(defun ledger-accounts-in-buffer ()
+  "Return an alist of accounts in the current buffer and its included files.
+The `car' of each element is the account name and the `cdr' is an
+alist where the key is a subdirective such as \"assert\" and the
+value (if any) is the associated data.  In other words, if you've
+declared an account like so:
+
+account Assets:Checking
+    assert commodity == \"$\"
+    default
+
+Then one of the elements this function returns will be
+\(\"Assets:Checking\"
+  (\"default\")
+  (\"assert\" . \"commodity == \"$\"\"))"
+  (ledger-complete--index-ensure)
+  (let ((merged (make-hash-table :test #'equal))
+        account-list)
+    (maphash (lambda (account entry) (puthash account entry merged))
+             ledger-complete--account-index)
+    (dolist (file-entry (ledger-complete--include-entries))
+      (maphash (lambda (account entry)
+                 (unless (gethash account merged)
+                   (puthash account entry merged)))
+               (plist-get file-entry :accounts)))
+    (maphash (lambda (account entry)
+               ;; FIXME: People who have set `ledger-flymake-be-pedantic' to
+               ;; non-nil probably don't want accounts from postings, just
+               ;; those declared with directives.  But the name is a little
+               ;; misleading.  Should we make a ledger-mode-be-pedantic and
+               ;; use that instead?
+               (when (or (> (aref entry 1) 0)
+                         (not (bound-and-true-p ledger-flymake-be-pedantic)))
+                 (push (cons account (aref entry 2)) account-list)))
+             merged)
+    (sort account-list (lambda (a b) (string-lessp (car a) (car b))))))
 
 (defun ledger-accounts-list-in-buffer ()
   "Return a list of all known account names in the current buffer as strings.
@@ -172,6 +583,36 @@ Looks in `ledger-accounts-file' if set, otherwise the current buffer."
           (ledger-accounts-list-in-buffer)))
     (ledger-accounts-list-in-buffer)))
 
+(defun ledger-complete--xact-payee ()
+  "Return the payee of the transaction containing point, if any."
+  (save-excursion
+    (save-match-data
+      (ledger-navigate-beginning-of-xact)
+      (and (looking-at ledger-payee-any-status-regex)
+           (match-string-no-properties 3)))))
+
+(defun ledger-accounts-list-for-payee ()
+  "Return the account list, the current payee's historical accounts first.
+When the transaction being completed has a payee known to the
+index, the accounts that payee has been posted to before are
+offered ahead of the rest, ordered by how often they occur; the
+remaining accounts follow in their usual order.  Falls back to
+`ledger-accounts-list' when the payee is unknown."
+  (let* ((accounts (ledger-accounts-list))
+         (payee (ledger-complete--xact-payee))
+         (table (and payee
+                     ledger-complete--payee-accounts
+                     (gethash payee ledger-complete--payee-accounts))))
+    (if (and table (> (hash-table-count table) 0))
+        (let (historical)
+          (maphash (lambda (account count) (push (cons account count) historical))
+                   table)
+          (setq historical (sort historical (lambda (a b) (> (cdr a) (cdr b)))))
+          (let ((names (mapcar #'car historical)))
+            (append (cl-remove-if-not (lambda (a) (member a accounts)) names)
+                    (cl-remove-if (lambda (a) (member a names)) accounts))))
+      accounts)))
+
 (defun ledger-find-accounts-in-buffer ()
   (let ((account-tree (list t))
         (account-elements nil)
@@ -305,7 +746,7 @@ Looks in `ledger-accounts-file' if set, otherwise the current buffer."
                  realign-after t
                  collection (if ledger-complete-in-steps
                                 #'ledger-accounts-tree
-                              #'ledger-accounts-list))))
+                              #'ledger-accounts-list-for-payee))))
     (when collection
       (let ((prefix (buffer-substring-no-properties start end)))
         (list start end
@@ -324,6 +765,22 @@ Looks in `ledger-accounts-file' if set, otherwise the current buffer."
 (defun ledger-trim-trailing-whitespace (str)
   (replace-regexp-in-string "[ \t]*$" "" str))
 
+(defun ledger-complete--payee-donor (name)
+  "Return the position of the last indexed transaction for payee NAME.
+The cached marker is re-verified against the buffer before use;
+return nil when NAME is unknown or the entry has gone stale, in
+which case the caller falls back to searching."
+  (and ledger-complete--payee-last-pos
+       (let ((marker (gethash name ledger-complete--payee-last-pos)))
+         (when (and marker (marker-position marker))
+           (save-excursion
+             (save-match-data
+               (goto-char marker)
+               (forward-line 0)
+               (and (looking-at ledger-payee-any-status-regex)
+                    (equal (match-string-no-properties 3) name)
+                    (point))))))))
+
 (defun ledger-fully-complete-xact ()
   "Completes a transaction if there is another matching payee in the buffer.
 
@@ -334,17 +791,30 @@ payee."
   (let* ((name (ledger-trim-trailing-whitespace (caar (ledger-parse-arguments))))
          (rest-of-name name)
          xacts)
+    (ledger-complete--index-ensure)
     (save-excursion
       (when (eq 'transaction (ledger-thing-at-point))
         (delete-region (point) (+ (length name) (point)))
-        ;; Search backward for a matching payee
-        (when (re-search-backward
-               (concat "^[0-9/.=-]+\\(\\s-+\\*\\)?\\(\\s-+(.*?)\\)?\\s-+\\(.*"
-                       (regexp-quote name) ".*\\)" ) nil t)
-          (setq rest-of-name (match-string 3))
-          ;; Start copying the postings
-          (forward-line)
-          (setq xacts (buffer-substring-no-properties (point) (ledger-navigate-end-of-xact))))))
+        ;; Jump straight to the payee's last indexed transaction when
+        ;; the index knows it; otherwise search backward for a
+        ;; matching payee as before
+        (let ((payee-regex (concat "^[0-9/.=-]+\\(\\s-+\\*\\)?\\(\\s-+(.*?)\\)?\\s-+\\(.*"
+                                   (regexp-quote name) ".*\\)"))
+              (donor (ledger-complete--payee-donor name)))
+          (when (if donor
+                    (progn (goto-char donor)
+                           (looking-at payee-regex))
+                  (when (re-search-backward payee-regex nil t)
+                    ;; remember the donor so the next completion for
+                    ;; this payee skips the search
+                    (when ledger-complete--payee-last-pos
+                      (puthash name (copy-marker (point))
+                               ledger-complete--payee-last-pos))
+                    t))
+            (setq rest-of-name (match-string 3))
+            ;; Start copying the postings
+            (forward-line)
+            (setq xacts (buffer-substring-no-properties (point) (ledger-navigate-end-of-xact)))))))
     ;; Insert rest-of-name and the postings
     (save-excursion
       (insert rest-of-name ?\n)
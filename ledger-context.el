@@ -78,13 +78,18 @@
                                       (ledger-single-line-config indent account comment)
                                       (ledger-single-line-config indent account)))))
 
-(defun ledger-extract-context-info (line-type pos)
-  "Get context info for current line with LINE-TYPE.
+(defvar-local ledger-context--line-cache nil
+  "Hash table from a line start position to its parsed fields.
+Filled lazily by `ledger-extract-context-info'.")
 
-Assumes point is at beginning of line, and the POS argument specifies
-where the \"users\" point was."
+(defvar-local ledger-context--line-cache-tick nil
+  "Value of `buffer-chars-modified-tick' the line cache is valid for.")
+
+(defun ledger-context--parse-line (line-type)
+  "Parse the current line as LINE-TYPE and return its list of fields.
+Assumes point is at the beginning of the line."
   (let ((linfo (assoc line-type ledger-line-config))
-        found field fields)
+        found fields)
     (dolist (re-info (nth 1 linfo))
       (let ((re (nth 0 re-info))
             (names (nth 1 re-info)))
@@ -97,11 +102,31 @@ where the \"users\" point was."
                                      (list
                                       (list (nth i names)
                                             (match-string-no-properties (1+ i))
-                                            (match-beginning (1+ i))))))))
-            (dolist (f fields)
-              (and (nth 1 f)
-                   (>= pos (nth 2 f))
-                   (setq field (nth 0 f))))))))
+                                            (match-beginning (1+ i))))))))))))
+    fields))
+
+(defun ledger-extract-context-info (line-type pos)
+  "Get context info for current line with LINE-TYPE.
+
+Assumes point is at beginning of line, and the POS argument specifies
+where the \"users\" point was.  The parsed fields of each line
+are cached against its start position until the buffer is edited,
+so repeated calls on an unchanged line skip the regex cascade."
+  (let ((tick (buffer-chars-modified-tick)))
+    (unless (and ledger-context--line-cache
+                 (eq tick ledger-context--line-cache-tick))
+      (setq ledger-context--line-cache (make-hash-table :test #'eql)
+            ledger-context--line-cache-tick tick)))
+  (let* ((cached (gethash (point) ledger-context--line-cache 'miss))
+         (fields (if (eq cached 'miss)
+                     (puthash (point) (ledger-context--parse-line line-type)
+                              ledger-context--line-cache)
+                   cached))
+         field)
+    (dolist (f fields)
+      (and (nth 1 f)
+           (>= pos (nth 2 f))
+           (setq field (nth 0 f))))
     (list line-type field fields)))
 
 (defun ledger-thing-at-point ()
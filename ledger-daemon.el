@@ -0,0 +1,196 @@
+;;; ledger-daemon.el --- Helper code for use with the "ledger" command-line tool  -*- lexical-binding: t; -*-
+
+;; Copyright (C) 2003-2016 John Wiegley (johnw AT gnu DOT org)
+
+;; This file is not part of GNU Emacs.
+
+;; This is free software; you can redistribute it and/or modify it under
+;; the terms of the GNU General Public License as published by the Free
+;; Software Foundation; either version 2, or (at your option) any later
+;; version.
+;;
+;; This is distributed in the hope that it will be useful, but WITHOUT
+;; ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+;; FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+;; for more details.
+;;
+;; You should have received a copy of the GNU General Public License
+;; along with GNU Emacs; see the file COPYING.  If not, write to the
+;; Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+;; MA 02110-1301 USA.
+
+;;; Commentary:
+;; Keep a long-lived ledger process warm per journal file.
+;;
+;; Every invocation through `ledger-exec-ledger' spawns a fresh ledger
+;; process which re-parses the whole journal from scratch; on large
+;; journals the parse dominates the latency of every report and balance
+;; query.  Ledger run without a command enters its interactive REPL,
+;; which parses the journal once and then answers commands from stdin.
+;; This file maintains one such REPL process per journal file, pipes
+;; commands to it, and restarts it transparently when the file changes
+;; on disk.  Enable it by setting `ledger-daemon-use-daemon'.
+
+;;; Code:
+
+(require 'ledger-exec)
+
+(defgroup ledger-daemon nil
+  "Persistent ledger process support for ledger-mode."
+  :group 'ledger)
+
+(defcustom ledger-daemon-use-daemon nil
+  "When non-nil, run queries against a persistent ledger process.
+The process parses the journal once and stays warm, so repeated
+reports and balance queries skip the per-command startup and
+parse cost.  It is only consulted for buffers that visit a file
+and have no unsaved modifications; other requests fall back to
+spawning a fresh process.
+
+Staleness is detected from the modification time of the master
+file alone.  After editing a file pulled in by an include
+directive, run `ledger-daemon-stop' (or touch the master file) to
+force a fresh parse."
+  :type 'boolean
+  :group 'ledger-daemon
+  :package-version '(ledger-mode . "4.0.1"))
+
+(defvar ledger-daemon--processes (make-hash-table :test #'equal)
+  "Hash table mapping journal file names to their warm ledger process.")
+
+(defun ledger-daemon--file-time (file)
+  "Return the modification time of FILE."
+  (file-attribute-modification-time (file-attributes file)))
+
+(defun ledger-daemon--start (file)
+  "Start a ledger REPL process reading the journal FILE."
+  (ledger-exec-check-binary)
+  (let* ((coding-system-for-write 'utf-8)
+         (coding-system-for-read 'utf-8)
+         (process (make-process
+                   :name "ledger-daemon"
+                   :buffer (generate-new-buffer " *ledger-daemon*")
+                   :connection-type 'pipe
+                   :noquery t
+                   :command (list ledger-binary-path "-f" file
+                                  "--date-format" ledger-default-date-format)
+                   :filter #'ledger-daemon--filter
+                   :sentinel #'ledger-daemon--sentinel)))
+    (process-put process 'ledger-daemon-file file)
+    (process-put process 'ledger-daemon-file-time (ledger-daemon--file-time file))
+    (puthash file process ledger-daemon--processes)
+    process))
+
+(defun ledger-daemon--kill (process)
+  "Terminate the warm ledger PROCESS and release its buffer."
+  (remhash (process-get process 'ledger-daemon-file) ledger-daemon--processes)
+  (when (process-live-p process)
+    (delete-process process))
+  (when (buffer-live-p (process-buffer process))
+    (kill-buffer (process-buffer process))))
+
+(defun ledger-daemon-process (file)
+  "Return a live ledger process for FILE, starting or restarting as needed.
+The process is restarted when FILE has changed on disk since the
+process last parsed it."
+  (setq file (expand-file-name file))
+  (let ((process (gethash file ledger-daemon--processes)))
+    ;; Only FILE itself is watched for staleness.  Edits to files it
+    ;; includes are not detected; see `ledger-daemon-use-daemon'.
+    (when (and process
+               (or (not (process-live-p process))
+                   (not (equal (process-get process 'ledger-daemon-file-time)
+                               (ledger-daemon--file-time file)))))
+      (ledger-daemon--kill process)
+      (setq process nil))
+    (or process (ledger-daemon--start file))))
+
+(defun ledger-daemon-exec (file command callback)
+  "Run the ledger COMMAND line against the warm process for FILE.
+CALLBACK is called with a buffer containing the command's output;
+the buffer is killed after CALLBACK returns.  Commands for the
+same process are queued and answered in order."
+  (let ((process (ledger-daemon-process file)))
+    (process-put process 'ledger-daemon-queue
+                 (nconc (process-get process 'ledger-daemon-queue)
+                        (list (cons command callback))))
+    (ledger-daemon--send-next process)))
+
+(defun ledger-daemon--send-next (process)
+  "Send the next queued command to PROCESS unless one is in flight.
+Nothing is sent until the REPL has printed its startup prompt;
+commands queued before that are dispatched by the filter when the
+prompt arrives."
+  (unless (or (not (process-get process 'ledger-daemon-ready))
+              (process-get process 'ledger-daemon-callback))
+    (let ((next (car (process-get process 'ledger-daemon-queue))))
+      (when next
+        (process-put process 'ledger-daemon-queue
+                     (cdr (process-get process 'ledger-daemon-queue)))
+        (process-put process 'ledger-daemon-callback (cdr next))
+        (with-current-buffer (process-buffer process)
+          (erase-buffer))
+        (process-send-string process (concat (car next) "\n"))))))
+
+(defun ledger-daemon--prompt-start ()
+  "Return the position of a trailing REPL prompt in the current buffer."
+  (save-excursion
+    (goto-char (point-max))
+    (when (re-search-backward "\\(?:\\`\\|\n\\)\\(\\] \\)\\'" nil t)
+      (match-beginning 1))))
+
+(defun ledger-daemon--filter (process output)
+  "Accumulate OUTPUT from PROCESS and deliver it at the next prompt."
+  (let ((buf (process-buffer process)))
+    (when (buffer-live-p buf)
+      (with-current-buffer buf
+        (goto-char (point-max))
+        (insert output)
+        (let ((prompt (ledger-daemon--prompt-start)))
+          (when prompt
+            (if (not (process-get process 'ledger-daemon-ready))
+                ;; The first prompt is the REPL's startup greeting, not
+                ;; a response; discard it and start serving the queue.
+                (progn
+                  (erase-buffer)
+                  (process-put process 'ledger-daemon-ready t)
+                  (ledger-daemon--send-next process))
+              (let ((callback (process-get process 'ledger-daemon-callback))
+                    (result (buffer-substring (point-min) prompt)))
+                (erase-buffer)
+                (process-put process 'ledger-daemon-callback nil)
+                (when callback
+                  (with-temp-buffer
+                    (insert result)
+                    (funcall callback (current-buffer))))
+                (ledger-daemon--send-next process)))))))))
+
+(defun ledger-daemon--sentinel (process _event)
+  "Clean up after the warm ledger PROCESS exits."
+  (unless (process-live-p process)
+    (ledger-daemon--kill process)))
+
+(defun ledger-daemon-try-exec (input-buffer callback args)
+  "Hand the query ARGS on INPUT-BUFFER to a warm ledger process, if possible.
+The warm process reads the journal from disk, so it is only used
+when INPUT-BUFFER visits a file with no unsaved modifications.
+Return non-nil when the request was handled, in which case
+CALLBACK will be called with a buffer containing the output."
+  (let ((file (buffer-file-name input-buffer)))
+    (when (and ledger-daemon-use-daemon
+               args
+               file
+               (not (buffer-modified-p input-buffer))
+               (file-exists-p file))
+      (ledger-daemon-exec file (combine-and-quote-strings args) callback)
+      t)))
+
+(defun ledger-daemon-stop ()
+  "Terminate all warm ledger processes."
+  (interactive)
+  (maphash (lambda (_file process) (ledger-daemon--kill process))
+           ledger-daemon--processes))
+
+(provide 'ledger-daemon)
+
+;;; ledger-daemon.el ends here
@@ -21,10 +21,13 @@
 
 
 ;;; Commentary:
-;; Code for executing ledger synchronously.
+;; Code for executing ledger, either synchronously or asynchronously
+;; through a small queue of pending invocations.
 
 ;;; Code:
 
+(require 'cl-lib)
+
 (declare-function ledger-master-file "ledger-report" ())
 
 (defconst ledger-version-needed "3.0.0"
@@ -67,16 +70,20 @@
         nil  ;; failure, there is an error starting with "While"
       ledger-output-buffer)))
 
+(defun ledger-exec-check-binary ()
+  "Raise an error unless `ledger-binary-path' names an executable."
+  (unless (and ledger-binary-path
+               (or (and (file-exists-p ledger-binary-path)
+                        (file-executable-p ledger-binary-path))
+                   (executable-find ledger-binary-path)))
+    (error "`ledger-binary-path' (value: %s) is not executable" ledger-binary-path)))
+
 (defun ledger-exec-ledger (input-buffer &optional output-buffer &rest args)
   "Run Ledger using INPUT-BUFFER.
 Optionally capture output in OUTPUT-BUFFER, and pass ARGS on the
 command line.  Returns OUTPUT-BUFFER if ledger succeeded,
 otherwise the error output is displayed and an error is raised."
-  (unless (and ledger-binary-path
-               (or (and (file-exists-p ledger-binary-path)
-                        (file-executable-p ledger-binary-path))
-                   (executable-find ledger-binary-path)))
-    (error "`ledger-binary-path' (value: %s) is not executable" ledger-binary-path))
+  (ledger-exec-check-binary)
   (let ((buf (or input-buffer (find-file-noselect (ledger-master-file))))
         (outbuf (or output-buffer
                     (generate-new-buffer " *ledger-tmp*")))
@@ -97,6 +104,119 @@ otherwise the error output is displayed and an error is raised."
               (error "Ledger execution failed"))))
       (delete-file errfile))))
 
+;;; Asynchronous execution
+;;
+;; Async invocations go through a small scheduler: requests are queued
+;; and run one at a time, and a request for the same input buffer and
+;; arguments as one that is still queued or running supersedes it, so
+;; rapid-fire refreshes (auto-refreshing reports, flymake checks while
+;; typing) never pile up behind each other.
+
+(defvar ledger-exec--process nil
+  "The currently running asynchronous ledger process, if any.")
+
+(defvar ledger-exec--pending nil
+  "Queue of pending asynchronous ledger invocations.
+Each element is a list (KEY INPUT-BUFFER CALLBACK ARGS) as
+constructed by `ledger-exec-ledger-async'.")
+
+(defun ledger-exec-handle-error-buffer (errbuf)
+  "Deal with ledger errors contained in the buffer ERRBUF."
+  (with-current-buffer (get-buffer-create "*Ledger Error*")
+    (let ((buffer-read-only nil))
+      (delete-region (point-min) (point-max))
+      (insert-buffer-substring errbuf))
+    (view-mode)
+    (setq buffer-read-only t)
+    (current-buffer)))
+
+(defun ledger-exec-ledger-async (input-buffer callback &rest args)
+  "Run Ledger asynchronously using INPUT-BUFFER, passing ARGS on the command line.
+When ledger succeeds, CALLBACK is called with the buffer
+containing its output; the buffer is killed after CALLBACK
+returns, so CALLBACK must copy out anything it wants to keep.  On
+failure the error output is displayed and CALLBACK is not called.
+
+Invocations are queued and run one at a time.  Submitting a
+request with the same INPUT-BUFFER and ARGS as one still queued
+or running supersedes the old one: a queued duplicate is dropped
+and a running one is cancelled without invoking its callback."
+  (ledger-exec-check-binary)
+  (let* ((buf (or input-buffer (find-file-noselect (ledger-master-file))))
+         (key (cons buf args)))
+    ;; A warm ledger-daemon process can answer without re-parsing the
+    ;; journal; fall back to a fresh process when it cannot.
+    (unless (and (bound-and-true-p ledger-daemon-use-daemon)
+                 (fboundp 'ledger-daemon-try-exec)
+                 (ledger-daemon-try-exec buf callback args))
+      (setq ledger-exec--pending
+            (cl-delete key ledger-exec--pending :key #'car :test #'equal))
+      (when (and ledger-exec--process
+                 (process-live-p ledger-exec--process)
+                 (equal key (process-get ledger-exec--process 'ledger-exec-key)))
+        (process-put ledger-exec--process 'ledger-exec-superseded t)
+        (delete-process ledger-exec--process))
+      (setq ledger-exec--pending
+            (nconc ledger-exec--pending (list (list key buf callback args))))
+      (ledger-exec--run-next))))
+
+(defun ledger-exec--run-next ()
+  "Start the next queued ledger invocation unless one is running."
+  (while (and ledger-exec--pending
+              (not (and ledger-exec--process
+                        (process-live-p ledger-exec--process))))
+    (let* ((request (pop ledger-exec--pending))
+           (key (nth 0 request))
+           (buf (nth 1 request))
+           (callback (nth 2 request))
+           (args (nth 3 request)))
+      (when (buffer-live-p buf)
+        (let* ((outbuf (generate-new-buffer " *ledger-async*"))
+               (errbuf (generate-new-buffer " *ledger-async-stderr*"))
+               (coding-system-for-write 'utf-8)
+               (coding-system-for-read 'utf-8)
+               (process (make-process
+                         :name "ledger"
+                         :buffer outbuf
+                         :stderr errbuf
+                         :connection-type 'pipe
+                         :noquery t
+                         :command `(,ledger-binary-path "-f" "-"
+                                    "--date-format" ,ledger-default-date-format
+                                    ,@args)
+                         :sentinel #'ledger-exec--sentinel)))
+          (set-process-sentinel (get-buffer-process errbuf) #'ignore)
+          (process-put process 'ledger-exec-key key)
+          (process-put process 'ledger-exec-callback callback)
+          (process-put process 'ledger-exec-stderr errbuf)
+          (setq ledger-exec--process process)
+          (with-current-buffer buf
+            (process-send-region process (point-min) (point-max)))
+          (process-send-eof process))))))
+
+(defun ledger-exec--sentinel (process _event)
+  "Handle termination of the asynchronous ledger PROCESS."
+  (when (memq (process-status process) '(exit signal))
+    (let ((outbuf (process-buffer process))
+          (errbuf (process-get process 'ledger-exec-stderr))
+          (callback (process-get process 'ledger-exec-callback))
+          (superseded (process-get process 'ledger-exec-superseded)))
+      (when (eq process ledger-exec--process)
+        (setq ledger-exec--process nil))
+      (unwind-protect
+          (unless superseded
+            (if (and (eq (process-status process) 'exit)
+                     (ledger-exec-success-p (process-exit-status process) outbuf))
+                (funcall callback outbuf)
+              (display-buffer (ledger-exec-handle-error-buffer errbuf))
+              (message "Ledger execution failed")))
+        (let ((errproc (and (buffer-live-p errbuf)
+                            (get-buffer-process errbuf))))
+          (when errproc (delete-process errproc)))
+        (when (buffer-live-p outbuf) (kill-buffer outbuf))
+        (when (buffer-live-p errbuf) (kill-buffer errbuf))
+        (ledger-exec--run-next)))))
+
 (defun ledger-version-greater-p (needed)
   "Verify the ledger binary is usable for `ledger-mode' (version greater than NEEDED)."
   (let ((version-strings '()))
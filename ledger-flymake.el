@@ -35,6 +35,20 @@
 
 (defvar-local ledger--flymake-proc nil)
 
+(defvar-local ledger--flymake-timer nil
+  "Debounce timer for the next scheduled check, or nil.")
+
+(defvar-local ledger--flymake-report-fn nil
+  "REPORT-FN of the most recent check request.")
+
+(defcustom ledger-flymake-debounce-interval 0.5
+  "Seconds of quiet before a requested check actually runs.
+Check requests arriving within this interval are coalesced, so a
+burst of saves costs a single parse of the journal."
+  :type 'number
+  :package-version '(ledger-mode . "4.0.1")
+  :group 'ledger)
+
 (defcustom ledger-flymake-be-pedantic nil
   "If non-nil, pass the --pedantic flag for ledger to the flymake backend.
 If --pedantic is in your ledgerrc file, then --pedantic gets
@@ -55,9 +69,28 @@ passed regardless of the value."
 (defun ledger-flymake (report-fn &rest _args)
   "A Flymake backend for `ledger-mode'.
 
-Flymake calls this with REPORT-FN as needed."
+Flymake calls this with REPORT-FN as needed.  The check itself is
+debounced: it only starts once no further check has been
+requested for `ledger-flymake-debounce-interval' seconds, and
+only the newest REPORT-FN is answered."
   (unless (executable-find ledger-binary-path)
     (error "Cannot find ledger"))
+  (setq ledger--flymake-report-fn report-fn)
+  (when (timerp ledger--flymake-timer)
+    (cancel-timer ledger--flymake-timer))
+  (setq ledger--flymake-timer
+        (run-with-timer ledger-flymake-debounce-interval nil
+                        #'ledger--flymake-start (current-buffer))))
+
+(defun ledger--flymake-start (source-buffer)
+  "Run the debounced check in SOURCE-BUFFER."
+  (when (buffer-live-p source-buffer)
+    (with-current-buffer source-buffer
+      (setq ledger--flymake-timer nil)
+      (ledger--flymake-check ledger--flymake-report-fn))))
+
+(defun ledger--flymake-check (report-fn)
+  "Check the current buffer and report diagnostics through REPORT-FN."
   ;; If a live process launched in an earlier check was found, that
   ;; process is killed.  When that process's sentinel eventually runs,
   ;; it will notice its obsoletion, since it have since reset
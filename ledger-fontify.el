@@ -41,11 +41,40 @@
   :type 'boolean
   :group 'ledger)
 
+(defvar-local ledger-fontify--extent-cache nil
+  "Hash table mapping a line start to the extents of its element.
+Filled lazily by `ledger-fontify--element-extents'.")
+
+(defvar-local ledger-fontify--extent-tick nil
+  "Value of `buffer-chars-modified-tick' the extent cache is valid for.")
+
+(defun ledger-fontify--element-extents (pos)
+  "Return the extents of the element at POS, caching the result.
+Every line of an element already visited maps to its extents, so
+extending a jit-lock region inside a long multiline element is a
+hash lookup instead of a regex search past the window.  Any
+buffer edit invalidates the whole cache."
+  (let ((tick (buffer-chars-modified-tick)))
+    (unless (and ledger-fontify--extent-cache
+                 (eq tick ledger-fontify--extent-tick))
+      (setq ledger-fontify--extent-cache (make-hash-table :test #'eql)
+            ledger-fontify--extent-tick tick)))
+  (let ((line (save-excursion (goto-char pos) (line-beginning-position))))
+    (or (gethash line ledger-fontify--extent-cache)
+        (save-excursion
+          (let ((extents (ledger-navigate-find-element-extents pos)))
+            (goto-char (car extents))
+            (while (< (point) (cadr extents))
+              (puthash (line-beginning-position) extents
+                       ledger-fontify--extent-cache)
+              (forward-line))
+            extents)))))
+
 (defun ledger-fontify-extend-region ()
   "Extend fontification region to include whole transactions or directives."
   (save-match-data
-    (let* ((new-beg (min font-lock-beg (car (ledger-navigate-find-element-extents font-lock-beg))))
-           (new-end (max font-lock-end (cadr (ledger-navigate-find-element-extents font-lock-end))))
+    (let* ((new-beg (min font-lock-beg (car (ledger-fontify--element-extents font-lock-beg))))
+           (new-end (max font-lock-end (cadr (ledger-fontify--element-extents font-lock-end))))
            (changed (or (/= new-beg font-lock-beg)
                         (/= new-end font-lock-end))))
       (setq font-lock-beg new-beg)
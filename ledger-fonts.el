@@ -475,6 +475,44 @@ See `font-lock-keywords' for the full description."
               ,@(cdr item)))
           subdirectives))
 
+(defconst ledger-font-directive-faces
+  '(("assert" ledger-font-assert-directive-face ledger-font-assert-condition-face)
+    ("bucket" ledger-font-bucket-directive-face ledger-font-bucket-account-face)
+    ("A" ledger-font-bucket-directive-face ledger-font-bucket-account-face)
+    ("check" ledger-font-check-directive-face ledger-font-check-condition-face)
+    ("D" ledger-font-D-directive-face ledger-font-commodity-format-face)
+    ("endfixed" ledger-font-end-directive-face ledger-font-fixed-commodity-face)
+    ("expr" ledger-font-expr-directive-face ledger-font-expr-expression-face)
+    ("include" ledger-font-include-directive-face ledger-font-include-filename-face)
+    ("N" ledger-font-N-directive-face ledger-font-N-symbol-face)
+    ("year" ledger-font-year-directive-face ledger-font-year-face)
+    ("Y" ledger-font-year-directive-face ledger-font-year-face))
+  "Keyword and argument faces for the single-line directives.
+Each element has the form (KEYWORD KEYWORD-FACE ARGUMENT-FACE).
+Directives with subdirectives or several arguments keep their own
+entries in `ledger-font-lock-keywords'.")
+
+(defconst ledger-font-directive-face-table
+  (let ((table (make-hash-table :test #'equal)))
+    (dolist (entry ledger-font-directive-faces)
+      (puthash (car entry) (cdr entry) table))
+    table)
+  "Hash table from a directive keyword to its list of faces.")
+
+(defconst ledger-font-directive-regex
+  (concat "^" (regexp-opt (mapcar #'car ledger-font-directive-faces) t)
+          "\\(?:[[:blank:]]+\\(.*\\)\\)?$")
+  "Shared matcher for the directives in `ledger-font-directive-faces'.
+Precomputed at load time so that font-lock scans each line with
+one alternation instead of one regex per directive.")
+
+(defun ledger-font-directive-face (num)
+  "Return the face for group NUM of `ledger-font-directive-regex'.
+Group 1 is the directive keyword, group 2 its argument; the face
+is looked up from the keyword just matched."
+  (nth (1- num) (gethash (match-string-no-properties 1)
+                         ledger-font-directive-face-table)))
+
 (defvar ledger-font-lock-keywords
   `(("^[;#%|*].*$" . 'ledger-font-comment-face)
     ("^\\(account\\)\\(?:[[:blank:]]\\(.*\\)\\)?$"
@@ -514,12 +552,9 @@ See `font-lock-keywords' for the full description."
      (3 'ledger-font-apply-account-face nil :lax)
      (4 'ledger-font-apply-directive-face nil :lax)
      (5 'ledger-font-apply-tag-face nil :lax))
-    ("^\\(assert\\)\\(?:[[:blank:]]+\\(.*\\)\\)?$"
-     (1 'ledger-font-assert-directive-face)
-     (2 'ledger-font-assert-condition-face nil :lax))
-    ("^\\(bucket\\|A\\)\\(?:[[:blank:]]+\\(.*\\)\\)?$"
-     (1 'ledger-font-bucket-directive-face)
-     (2 'ledger-font-bucket-account-face nil :lax))
+    (,ledger-font-directive-regex
+     (1 (ledger-font-directive-face 1))
+     (2 (ledger-font-directive-face 2) nil :lax))
     (,(concat "^\\(C\\)"
               "\\(?:[[:blank:]]+\\([^=\n]*?\\)[[:blank:]]*"
               "\\(?:=[[:blank:]]*\\(.*\\)\\)?\\)?$")
@@ -532,9 +567,6 @@ See `font-lock-keywords' for the full description."
      (1 'ledger-font-capture-directive-face)
      (2 'ledger-font-capture-account-face nil :lax)
      (3 'ledger-font-capture-regex-face nil :lax))
-    ("^\\(check\\)\\(?:[[:blank:]]+\\(.*\\)\\)?$"
-     (1 'ledger-font-check-directive-face)
-     (2 'ledger-font-check-condition-face nil :lax))
     (,(concat "^\\(?:comment\\|test\\)\\>"
               "[^\0]*?\n"
               "end[[:blank:]]+\\(?:comment\\|test\\)\\>.*\n")
@@ -554,9 +586,6 @@ See `font-lock-keywords' for the full description."
            (1 'ledger-font-N-directive-face))
           ("^[ \t]+\\(default\\)\\>.*"
            (1 'ledger-font-default-directive-face)))))
-    ("^\\(D\\)\\(?:[[:blank:]]+\\(.*\\)\\)?$"
-     (1 'ledger-font-D-directive-face)
-     (2 'ledger-font-commodity-format-face nil :lax))
     (,(concat "^\\(define\\|def\\)"
               "\\(?:[[:blank:]]+\\([^=\n]*?\\)[[:blank:]]*"
               "\\(?:=[[:blank:]]*\\(.*\\)\\)?\\)?$")
@@ -569,22 +598,10 @@ See `font-lock-keywords' for the full description."
      (1 'ledger-font-end-directive-face)
      (2 'ledger-font-end-directive-face nil :lax)
      (3 'ledger-font-end-directive-face nil :lax))
-    ("^\\(endfixed\\)\\(?:[[:blank:]]+\\(.*\\)\\)?$"
-     (1 'ledger-font-end-directive-face)
-     (2 'ledger-font-fixed-commodity-face nil :lax))
-    ("^\\(expr\\)\\(?:[[:blank:]]+\\(.*\\)\\)?$"
-     (1 'ledger-font-expr-directive-face)
-     (2 'ledger-font-expr-expression-face nil :lax))
     ("^\\(fixed\\)\\(?:[[:blank:]]+\\([^[:blank:]\n]+\\)\\(?:[[:blank:]]+\\(.*\\)\\)?\\)?$"
      (1 'ledger-font-fixed-directive-face)
      (2 'ledger-font-fixed-commodity-face nil :lax)
      (3 'ledger-font-fixed-price-face nil :lax))
-    ("^\\(include\\)\\(?:[[:blank:]]+\\(.*\\)\\)?$"
-     (1 'ledger-font-include-directive-face)
-     (2 'ledger-font-include-filename-face nil :lax))
-    ("^\\(N\\)\\(?:[[:blank:]]+\\(.*\\)\\)?$"
-     (1 'ledger-font-N-directive-face)
-     (2 'ledger-font-N-symbol-face nil :lax))
     ("^\\(payee\\)\\(?:[[:blank:]]+\\(.*\\)\\)?$"
      (1 'ledger-font-payee-directive-face)
      (2 'ledger-font-payee-name-face nil :lax)
@@ -630,9 +647,6 @@ See `font-lock-keywords' for the full description."
                                                  ledger-font-payee-uncleared-face)) nil :lax)
      (5 'ledger-font-comment-face nil :lax))
     ("^\\([bh]\\)\\>.*$" (1 'ledger-font-timeclock-directive-face))
-    ("^\\(year\\|Y\\)\\(?:[[:blank:]]+\\(.*\\)\\)?$"
-     (1 'ledger-font-year-directive-face)
-     (2 'ledger-font-year-face nil :lax))
 
     (,(lambda (limit)
         (when ledger-fontify-xact-state-overrides
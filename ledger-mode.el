@@ -31,6 +31,7 @@
 (require 'ledger-commodities)
 (require 'ledger-complete)
 (require 'ledger-context)
+(require 'ledger-daemon)
 (require 'ledger-exec)
 (require 'ledger-fonts)
 (require 'ledger-fontify)
@@ -124,15 +125,15 @@ the balance into that."
   (interactive "P")
   (let* ((account (ledger-read-account-with-prompt "Account balance to show"))
          (target-commodity (when arg (ledger-read-commodity-with-prompt "Target commodity: ")))
-         (buffer (find-file-noselect (ledger-master-file)))
-         (balance (with-temp-buffer
-                    (apply 'ledger-exec-ledger buffer (current-buffer) "cleared" account
-                           (when target-commodity (list "-X" target-commodity)))
-                    (if (> (buffer-size) 0)
-                        (buffer-substring-no-properties (point-min) (1- (point-max)))
-                      (concat account " is empty.")))))
-    (when balance
-      (message balance))))
+         (buffer (find-file-noselect (ledger-master-file))))
+    (apply #'ledger-exec-ledger-async buffer
+           (lambda (output)
+             (message "%s" (with-current-buffer output
+                             (if (> (buffer-size) 0)
+                                 (buffer-substring-no-properties (point-min) (1- (point-max)))
+                               (concat account " is empty.")))))
+           "cleared" account
+           (when target-commodity (list "-X" target-commodity)))))
 
 (defun ledger-display-ledger-stats ()
   "Display the cleared-or-pending balance.
@@ -274,6 +275,7 @@ With a prefix argument, remove the effective date."
   '("Ledger"
     ["Narrow to REGEX" ledger-occur]
     ["Show all transactions" ledger-occur-mode ledger-occur-mode]
+    ["Search all journal files" ledger-occur-files]
     ["Ledger Statistics" ledger-display-ledger-stats ledger-works]
     "---"
     ["Show upcoming transactions" ledger-schedule-upcoming]
@@ -288,6 +290,7 @@ With a prefix argument, remove the effective date."
     "---"
     ["Toggle Current Transaction" ledger-toggle-current-transaction]
     ["Toggle Current Posting" ledger-toggle-current]
+    ["Toggle Region" ledger-toggle-region mark-active]
     ["Copy Trans at Point" ledger-copy-transaction-at-point]
     "---"
     ["Clean-up Buffer" ledger-mode-clean-buffer]
@@ -173,25 +173,92 @@ Requires empty line separating xacts."
         (ledger-navigate-find-xact-extents pos)
       (ledger-navigate-find-directive-extents pos))))
 
+(defvar-local ledger-navigate--uncleared-index nil
+  "Sorted list of markers at the start of each uncleared xact.
+Built by `ledger-navigate--uncleared-positions' and kept current
+by `ledger-navigate--uncleared-update', so jumping between sparse
+uncleared entries never rescans the whole buffer.")
+
+(defvar-local ledger-navigate--uncleared-tracking nil
+  "Non-nil once the uncleared index is built and tracking edits.")
+
+(defun ledger-navigate--uncleared-positions ()
+  "Return the uncleared index, scanning the buffer to build it if needed."
+  (unless ledger-navigate--uncleared-tracking
+    (save-excursion
+      (goto-char (point-min))
+      (let (markers)
+        (while (re-search-forward ledger-payee-uncleared-regex nil t)
+          (push (copy-marker (match-beginning 0)) markers))
+        (setq ledger-navigate--uncleared-index (nreverse markers))))
+    (add-hook 'after-change-functions #'ledger-navigate--uncleared-update nil t)
+    (setq ledger-navigate--uncleared-tracking t))
+  ledger-navigate--uncleared-index)
+
+(defun ledger-navigate--uncleared-update (beg end _len)
+  "Refresh the uncleared index for the lines covering BEG to END.
+Markers outside the changed lines keep adjusting on their own;
+only the affected lines are rescanned."
+  (when ledger-navigate--uncleared-tracking
+    (save-excursion
+      (save-match-data
+        (let ((lo (progn (goto-char beg) (line-beginning-position)))
+              (hi (progn (goto-char end) (line-end-position)))
+              kept new)
+          (dolist (m ledger-navigate--uncleared-index)
+            (if (and (>= m lo) (<= m hi))
+                (set-marker m nil)
+              (push m kept)))
+          (goto-char lo)
+          (while (re-search-forward ledger-payee-uncleared-regex hi t)
+            (push (copy-marker (match-beginning 0)) new))
+          (setq ledger-navigate--uncleared-index
+                (if new
+                    (sort (nconc new kept) #'<)
+                  (nreverse kept))))))))
+
+(defun ledger-navigate--uncleared-live-p (marker)
+  "Return non-nil if MARKER still marks an uncleared xact.
+Drop MARKER from the index otherwise, so edits made with
+modification hooks inhibited cannot leave stale entries behind."
+  (if (save-excursion
+        (goto-char marker)
+        (and (bolp) (looking-at-p ledger-payee-uncleared-regex)))
+      t
+    (set-marker marker nil)
+    (setq ledger-navigate--uncleared-index
+          (delq marker ledger-navigate--uncleared-index))
+    nil))
+
 (defun ledger-navigate-next-uncleared ()
   "Move point to the next uncleared transaction."
   (interactive)
-  (when (looking-at ledger-payee-uncleared-regex)
-    (forward-line))
-  (if (re-search-forward ledger-payee-uncleared-regex nil t)
-      (progn (beginning-of-line)
-             (point))
-    (user-error "No next uncleared transactions")))
+  (let ((target (catch 'found
+                  (dolist (marker (ledger-navigate--uncleared-positions))
+                    (when (and (> marker (point))
+                               (ledger-navigate--uncleared-live-p marker))
+                      (throw 'found marker))))))
+    (if target
+        (progn (goto-char target)
+               (beginning-of-line)
+               (point))
+      (user-error "No next uncleared transactions"))))
 
 (defun ledger-navigate-previous-uncleared ()
   "Move point to the previous uncleared transaction."
   (interactive)
   (when (equal (car (ledger-context-at-point)) 'acct-transaction)
     (ledger-navigate-beginning-of-xact))
-  (if (re-search-backward ledger-payee-uncleared-regex nil t)
-      (progn (beginning-of-line)
-             (point))
-    (user-error "No previous uncleared transactions")))
+  (let (target)
+    (dolist (marker (ledger-navigate--uncleared-positions))
+      (when (and (< marker (point))
+                 (ledger-navigate--uncleared-live-p marker))
+        (setq target marker)))
+    (if target
+        (progn (goto-char target)
+               (beginning-of-line)
+               (point))
+      (user-error "No previous uncleared transactions"))))
 
 
 (provide 'ledger-navigate)
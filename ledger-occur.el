@@ -32,7 +32,15 @@
 (require 'cl-lib)
 (require 'ledger-navigate)
 
-(defconst ledger-occur-overlay-property-name 'ledger-occur-custom-buffer-grep)
+(declare-function ledger-complete-journal-files "ledger-complete" ())
+
+;; Hiding is done with the invisible text property rather than overlays:
+;; a narrow regex over a huge journal produces one gap per match, and one
+;; overlay per gap degrades redisplay quadratically, whereas text
+;; properties scale with buffer size only.
+
+(defconst ledger-occur-invisibility-symbol 'ledger-occur
+  "Value of the invisible text property used to hide non-matching xacts.")
 
 (defcustom ledger-occur-use-face-shown t
   "If non-nil, use a custom face for xacts shown in `ledger-occur' mode.
@@ -58,21 +66,34 @@ This uses `ledger-occur-xact-face'."
   :keymap ledger-occur-mode-map
   (if (and ledger-occur-current-regex ledger-occur-mode)
       (ledger-occur-refresh)
-    (ledger-occur-remove-overlays)
+    (ledger-occur-remove-invisibility)
     (message "Showing all transactions")))
 
 (define-key ledger-occur-mode-map (kbd "C-c C-g") #'ledger-occur-refresh)
 (define-key ledger-occur-mode-map (kbd "C-c C-f") #'ledger-occur-mode)
 
 (defun ledger-occur-refresh ()
-  "Re-apply the current narrowing expression."
+  "Re-apply the current narrowing expression.
+The buffer scan aborts as soon as the user types, and is retried
+when Emacs becomes idle, so narrowing a very large buffer does
+not lock up the display."
   (interactive)
-  (let ((matches (ledger-occur-compress-matches
-                  (ledger-occur-find-matches ledger-occur-current-regex))))
-    (if matches
-        (ledger-occur-create-overlays matches)
-      (message "No matches found for '%s'" ledger-occur-current-regex)
-      (ledger-occur-mode -1))))
+  (when (eq t (while-no-input
+                (let ((matches (ledger-occur-compress-matches
+                                (ledger-occur-find-matches ledger-occur-current-regex))))
+                  (if matches
+                      (ledger-occur-apply-invisibility matches)
+                    (message "No matches found for '%s'" ledger-occur-current-regex)
+                    (ledger-occur-mode -1)))
+                nil))
+    (run-with-idle-timer 0.2 nil #'ledger-occur--deferred-refresh (current-buffer))))
+
+(defun ledger-occur--deferred-refresh (buffer)
+  "Retry an interrupted `ledger-occur-refresh' in BUFFER."
+  (when (buffer-live-p buffer)
+    (with-current-buffer buffer
+      (when (and ledger-occur-mode ledger-occur-current-regex)
+        (ledger-occur-refresh)))))
 
 (defun ledger-occur (regex)
   "Show only transactions in the current buffer which match REGEX.
@@ -104,36 +125,45 @@ currently active."
     (current-word)))
 
 
-(defun ledger-occur-make-visible-overlay (beg end)
-  (let ((ovl (make-overlay beg end (current-buffer))))
-    (overlay-put ovl ledger-occur-overlay-property-name t)
-    (when ledger-occur-use-face-shown
-      (overlay-put ovl 'font-lock-face 'ledger-occur-xact-face))))
-
-(defun ledger-occur-make-invisible-overlay (beg end)
-  (let ((ovl (make-overlay beg end (current-buffer))))
-    (overlay-put ovl ledger-occur-overlay-property-name t)
-    (overlay-put ovl 'invisible t)))
-
-(defun ledger-occur-create-overlays (ovl-bounds)
-  "Create the overlays for the visible transactions.
-Argument OVL-BOUNDS contains bounds for the transactions to be left visible."
-  (let* ((beg (caar ovl-bounds))
-         (end (cl-cadar ovl-bounds)))
-    (ledger-occur-remove-overlays)
-    (ledger-occur-make-invisible-overlay (point-min) (1- beg))
-    (dolist (visible (cdr ovl-bounds))
-      (ledger-occur-make-visible-overlay beg end)
-      (ledger-occur-make-invisible-overlay (1+ end) (1- (car visible)))
-      (setq beg (car visible))
-      (setq end (cadr visible)))
-    (ledger-occur-make-invisible-overlay (1+ end) (point-max))))
-
-(defun ledger-occur-remove-overlays ()
-  "Remove the transaction hiding overlays."
+(defun ledger-occur--hide-region (beg end)
+  "Mark the text from BEG to END invisible."
+  (when (< beg end)
+    (put-text-property beg end 'invisible ledger-occur-invisibility-symbol)))
+
+(defun ledger-occur--show-region (beg end)
+  "Highlight the visible text from BEG to END."
+  (when (and ledger-occur-use-face-shown (< beg end))
+    (put-text-property beg end 'font-lock-face 'ledger-occur-xact-face)))
+
+(defun ledger-occur-apply-invisibility (match-bounds)
+  "Hide the transactions not covered by MATCH-BOUNDS.
+MATCH-BOUNDS contains bounds for the transactions to be left
+visible.  Hiding is done in a single text-property pass, without
+allocating any overlays."
+  (let* ((beg (caar match-bounds))
+         (end (cl-cadar match-bounds)))
+    (ledger-occur-remove-invisibility)
+    (add-to-invisibility-spec ledger-occur-invisibility-symbol)
+    (with-silent-modifications
+      (ledger-occur--hide-region (point-min) (1- beg))
+      (dolist (visible (cdr match-bounds))
+        (ledger-occur--show-region beg end)
+        (ledger-occur--hide-region (1+ end) (1- (car visible)))
+        (setq beg (car visible))
+        (setq end (cadr visible)))
+      (ledger-occur--show-region beg end)
+      (ledger-occur--hide-region (1+ end) (point-max)))))
+
+(defun ledger-occur-remove-invisibility ()
+  "Remove the transaction-hiding text properties."
   (interactive)
-  (remove-overlays (point-min)
-                   (point-max) ledger-occur-overlay-property-name t))
+  (remove-from-invisibility-spec ledger-occur-invisibility-symbol)
+  (with-silent-modifications
+    (remove-text-properties (point-min) (point-max)
+                            '(invisible nil font-lock-face nil))))
+
+(define-obsolete-function-alias 'ledger-occur-remove-overlays
+  #'ledger-occur-remove-invisibility "4.0.1")
 
 (defun ledger-occur-find-matches (regex)
   "Return a list of 2-number tuples describing the beginning and end of transactions meeting REGEX."
@@ -165,6 +195,155 @@ Argument OVL-BOUNDS contains bounds for the transactions to be left visible."
             (setq current-end (cadr match))))
         (nreverse (push (list current-beginning current-end) points)))))
 
+;;; Cross-file occur over the include graph
+
+(defconst ledger-occur-files-buffer-name "*Ledger Occur*"
+  "Name of the buffer showing cross-file `ledger-occur-files' results.")
+
+(defvar ledger-occur-files--pending nil
+  "Journal files still waiting to be searched.")
+
+(defvar ledger-occur-files--files nil
+  "Complete file list of the last run, for `ledger-occur-files-rerun'.")
+
+(defvar ledger-occur-files--regex nil
+  "Pattern the current `ledger-occur-files' run is searching for.")
+
+(defvar ledger-occur-files--timer nil
+  "Timer driving the file-by-file search, or nil when idle.")
+
+(defvar ledger-occur-files--match-count 0
+  "Transactions found so far by the current run.")
+
+(define-button-type 'ledger-occur-file-entry
+  'follow-link t
+  'face 'ledger-font-report-clickable-face
+  'action (lambda (_button) (ledger-occur-files-visit-source)))
+
+(defvar ledger-occur-files-mode-map
+  (let ((map (make-sparse-keymap)))
+    (define-key map (kbd "RET") #'ledger-occur-files-visit-source)
+    (define-key map (kbd "g") #'ledger-occur-files-rerun)
+    map))
+
+(define-derived-mode ledger-occur-files-mode special-mode "Ledger-Occur"
+  "Mode for the aggregated `ledger-occur-files' results buffer.")
+
+(defun ledger-occur-files (regex)
+  "Search REGEX in every file of the journal's include graph.
+The files are read directly rather than visited, one per timer
+tick so Emacs stays responsive, and each matching transaction
+becomes a clickable line in an aggregated results buffer."
+  (interactive
+   (list (read-regexp "Regexp" (ledger-occur-prompt) 'ledger-occur-history)))
+  (when (zerop (length regex))
+    (user-error "Cannot search for an empty regexp"))
+  (require 'ledger-complete)
+  (let ((files (ledger-complete-journal-files)))
+    (unless files
+      (user-error "Buffer is not visiting a journal file"))
+    (ledger-occur-files--start files regex)))
+
+(defun ledger-occur-files--start (files regex)
+  "Begin searching REGEX over FILES, resetting the results buffer."
+  (when ledger-occur-files--timer
+    (cancel-timer ledger-occur-files--timer))
+  (setq ledger-occur-files--files files
+        ledger-occur-files--pending files
+        ledger-occur-files--regex regex
+        ledger-occur-files--match-count 0)
+  (with-current-buffer (get-buffer-create ledger-occur-files-buffer-name)
+    (let ((inhibit-read-only t))
+      (erase-buffer)
+      (insert (format "Transactions matching %s in %d file%s:\n\n"
+                      regex (length files) (if (cdr files) "s" ""))))
+    (ledger-occur-files-mode))
+  (setq ledger-occur-files--timer
+        (run-at-time 0 nil #'ledger-occur-files--step))
+  (display-buffer ledger-occur-files-buffer-name))
+
+(defun ledger-occur-files--step ()
+  "Search the next pending file and reschedule until none remain."
+  (setq ledger-occur-files--timer nil)
+  (let ((buf (get-buffer ledger-occur-files-buffer-name))
+        (file (pop ledger-occur-files--pending)))
+    ;; Stop quietly if the results buffer was killed mid-run.
+    (when (and buf (buffer-live-p buf) file)
+      (let ((matches (and (file-readable-p file)
+                          (ledger-occur-files--search-file
+                           file ledger-occur-files--regex))))
+        (with-current-buffer buf
+          (let ((inhibit-read-only t))
+            (save-excursion
+              (goto-char (point-max))
+              (dolist (match matches)
+                (ledger-occur-files--insert-match file match))))))
+      (if ledger-occur-files--pending
+          (setq ledger-occur-files--timer
+                (run-at-time 0.001 nil #'ledger-occur-files--step))
+        (with-current-buffer buf
+          (let ((inhibit-read-only t))
+            (save-excursion
+              (goto-char (point-max))
+              (insert (format "\n%d matching transaction%s\n"
+                              ledger-occur-files--match-count
+                              (if (= 1 ledger-occur-files--match-count)
+                                  "" "s"))))))
+        (message "ledger-occur-files: %d matching transactions"
+                 ledger-occur-files--match-count)))))
+
+(defun ledger-occur-files--search-file (file regex)
+  "Return matches for REGEX in FILE as a list of (LINE . TEXT).
+FILE is read into a temporary buffer, not visited.  LINE is the
+first line of the matching transaction and TEXT that line's
+contents; several matches inside one transaction produce a single
+entry."
+  (with-temp-buffer
+    (insert-file-contents file)
+    (let (matches)
+      (while (re-search-forward regex nil t)
+        (let ((bounds (ledger-navigate-find-element-extents (point))))
+          (goto-char (car bounds))
+          (push (cons (line-number-at-pos)
+                      (buffer-substring-no-properties
+                       (point) (line-end-position)))
+                matches)
+          (goto-char (cadr bounds))))
+      (nreverse matches))))
+
+(defun ledger-occur-files--insert-match (file match)
+  "Insert one clickable result line for MATCH (LINE . TEXT) in FILE."
+  (let ((beg (point)))
+    (insert (format "%s:%d: %s\n"
+                    (file-name-nondirectory file) (car match) (cdr match)))
+    (add-text-properties beg (1- (point))
+                         (list 'ledger-source (cons file (car match))))
+    (make-text-button beg (1- (point))
+                      'type 'ledger-occur-file-entry
+                      'help-echo (format "mouse-2, RET: Visit %s:%d"
+                                         file (car match)))
+    (cl-incf ledger-occur-files--match-count)))
+
+(defun ledger-occur-files-visit-source ()
+  "Visit the transaction the result line under point refers to."
+  (interactive)
+  (let* ((prop (get-text-property (point) 'ledger-source))
+         (file (car prop))
+         (line (cdr prop)))
+    (when (and file line)
+      (find-file-other-window file)
+      (widen)
+      (ledger-navigate-to-line line)
+      (ledger-navigate-beginning-of-xact))))
+
+(defun ledger-occur-files-rerun ()
+  "Run the last `ledger-occur-files' search again over the same files."
+  (interactive)
+  (unless (and ledger-occur-files--regex ledger-occur-files--files)
+    (user-error "No previous ledger-occur-files search"))
+  (ledger-occur-files--start ledger-occur-files--files
+                             ledger-occur-files--regex))
+
 (provide 'ledger-occur)
 
 ;;; ledger-occur.el ends here
@@ -0,0 +1,176 @@
+;;; ledger-perf.el --- Timing instrumentation for ledger-mode hot paths  -*- lexical-binding: t; -*-
+
+;; Copyright (C) 2003-2016 John Wiegley (johnw AT gnu DOT org)
+
+;; This file is not part of GNU Emacs.
+
+;; This is free software; you can redistribute it and/or modify it under
+;; the terms of the GNU General Public License as published by the Free
+;; Software Foundation; either version 2, or (at your option) any later
+;; version.
+;;
+;; This is distributed in the hope that it will be useful, but WITHOUT
+;; ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+;; FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+;; for more details.
+;;
+;; You should have received a copy of the GNU General Public License
+;; along with GNU Emacs; see the file COPYING.  If not, write to the
+;; Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+;; MA 02110-1301 USA.
+
+;;; Commentary:
+;; Opt-in instrumentation for the entry points that dominate
+;; ledger-mode's interactive latency.  Enable `ledger-perf-mode', work
+;; as usual, then run \\[ledger-perf-report] to see call counts,
+;; cumulative wall time and GC pauses per function, plus the most
+;; recent individual calls.  This is much lighter than the Emacs
+;; profiler and cheap enough to leave on while reproducing a slowdown.
+
+;;; Code:
+
+(require 'ring)
+
+(defgroup ledger-perf nil
+  "Options for ledger-mode performance instrumentation"
+  :group 'ledger)
+
+(defcustom ledger-perf-functions
+  '(ledger-exec-ledger
+    ledger-context-at-point
+    ledger-accounts-list-in-buffer
+    ledger-do-report
+    ledger-reconcile-refresh)
+  "Functions instrumented while `ledger-perf-mode' is enabled.
+Changing this while the mode is on takes effect the next time it
+is enabled."
+  :type '(repeat function)
+  :group 'ledger-perf
+  :package-version '(ledger-mode . "4.0.1"))
+
+(defcustom ledger-perf-ring-size 256
+  "Number of recent calls kept for the report's sample listing."
+  :type 'integer
+  :group 'ledger-perf
+  :package-version '(ledger-mode . "4.0.1"))
+
+(defvar ledger-perf--stats (make-hash-table :test #'eq)
+  "Hash table mapping functions to stats vectors.
+Each vector is [CALLS TOTAL-TIME MAX-TIME GC-COUNT GC-TIME].")
+
+(defvar ledger-perf--ring nil
+  "Ring of recent samples (FUNCTION TIME GC-COUNT GC-TIME).")
+
+(defvar ledger-perf--instrumented nil
+  "Functions currently carrying the timing advice.")
+
+(defun ledger-perf--record (fn elapsed gcs gc-time)
+  "Fold one call of FN taking ELAPSED seconds into the statistics.
+GCS and GC-TIME are the garbage collections run during the call
+and the time they took."
+  (let ((stats (or (gethash fn ledger-perf--stats)
+                   (puthash fn (vector 0 0.0 0.0 0 0.0) ledger-perf--stats))))
+    (aset stats 0 (1+ (aref stats 0)))
+    (aset stats 1 (+ (aref stats 1) elapsed))
+    (aset stats 2 (max (aref stats 2) elapsed))
+    (aset stats 3 (+ (aref stats 3) gcs))
+    (aset stats 4 (+ (aref stats 4) gc-time)))
+  (when ledger-perf--ring
+    (ring-insert ledger-perf--ring (list fn elapsed gcs gc-time))))
+
+(defun ledger-perf--make-advice (fn)
+  "Return a piece of :around advice timing calls of FN."
+  (lambda (orig &rest args)
+    (let ((start (current-time))
+          (gcs gcs-done)
+          (gc-time gc-elapsed))
+      (unwind-protect
+          (apply orig args)
+        (ledger-perf--record fn
+                             (float-time (time-subtract (current-time) start))
+                             (- gcs-done gcs)
+                             (- gc-elapsed gc-time))))))
+
+(defun ledger-perf--instrument ()
+  "Advise every function in `ledger-perf-functions'."
+  (dolist (fn ledger-perf-functions)
+    (when (fboundp fn)
+      (advice-add fn :around (ledger-perf--make-advice fn)
+                  '((name . ledger-perf)))
+      (push fn ledger-perf--instrumented))))
+
+(defun ledger-perf--uninstrument ()
+  "Remove the timing advice installed by `ledger-perf--instrument'."
+  (dolist (fn ledger-perf--instrumented)
+    (advice-remove fn 'ledger-perf))
+  (setq ledger-perf--instrumented nil))
+
+;;;###autoload
+(define-minor-mode ledger-perf-mode
+  "Record timing for the ledger-mode hot paths.
+While enabled, calls of the functions in `ledger-perf-functions'
+are counted and timed; \\[ledger-perf-report] shows the numbers
+and \\[ledger-perf-reset] starts over."
+  :global t
+  :group 'ledger-perf
+  (if ledger-perf-mode
+      (progn
+        (setq ledger-perf--ring (make-ring (max 1 ledger-perf-ring-size)))
+        (ledger-perf--instrument))
+    (ledger-perf--uninstrument)))
+
+(defun ledger-perf-reset ()
+  "Discard all recorded timing data."
+  (interactive)
+  (clrhash ledger-perf--stats)
+  (when ledger-perf--ring
+    (setq ledger-perf--ring (make-ring (max 1 ledger-perf-ring-size)))))
+
+(defun ledger-perf--stats-lines ()
+  "Return the per-function summary lines, worst cumulative time first."
+  (let (rows)
+    (maphash (lambda (fn stats) (push (cons fn stats) rows))
+             ledger-perf--stats)
+    (setq rows (sort rows (lambda (a b) (> (aref (cdr a) 1) (aref (cdr b) 1)))))
+    (mapcar (lambda (row)
+              (let ((stats (cdr row)))
+                (format "%-34s %6d %9.3fs %9.3fs %9.3fs %5d %8.3fs\n"
+                        (car row)
+                        (aref stats 0)
+                        (aref stats 1)
+                        (/ (aref stats 1) (aref stats 0))
+                        (aref stats 2)
+                        (aref stats 3)
+                        (aref stats 4))))
+            rows)))
+
+(defun ledger-perf-report ()
+  "Show recorded timing for the instrumented ledger-mode functions."
+  (interactive)
+  (let ((buf (get-buffer-create "*Ledger Perf*")))
+    (with-current-buffer buf
+      (let ((inhibit-read-only t))
+        (erase-buffer)
+        (insert (format "%-34s %6s %10s %10s %10s %5s %9s\n"
+                        "function" "calls" "total" "mean" "max" "GCs" "GC time"))
+        (insert (make-string 90 ?-) "\n")
+        (if (zerop (hash-table-count ledger-perf--stats))
+            (insert "No calls recorded.  Is ledger-perf-mode enabled?\n")
+          (apply #'insert (ledger-perf--stats-lines)))
+        (when (and ledger-perf--ring
+                   (> (ring-length ledger-perf--ring) 0))
+          (insert "\nMost recent calls:\n")
+          (dotimes (i (min 20 (ring-length ledger-perf--ring)))
+            (let ((sample (ring-ref ledger-perf--ring i)))
+              (insert (format "%-34s %9.3fs %5d GCs %8.3fs in GC\n"
+                              (nth 0 sample)
+                              (nth 1 sample)
+                              (nth 2 sample)
+                              (nth 3 sample))))))
+        (goto-char (point-min))
+        (special-mode)))
+    (display-buffer buf)))
+
+(provide 'ledger-perf)
+
+;;; ledger-perf.el ends here
@@ -97,37 +97,58 @@ Looks only as far as END, if supplied, otherwise `point-max'."
     (ledger-post-align-postings (car bounds) (cadr bounds))))
 
 (defun ledger-post-align-postings (beg end)
-  "Align all accounts and amounts between BEG and END, or the current region, or, if no region, the current line."
+  "Align all accounts and amounts between BEG and END, or the current region, or, if no region, the current line.
+The required adjustments are computed in a single scan and
+applied from the end of the region backwards, so lines that are
+already aligned cost no buffer edits at all."
   (interactive "r")
   (save-match-data
     (save-excursion
       (let ((inhibit-modification-hooks t)
             ;; Extend region to whole lines
             (beg (save-excursion (goto-char beg) (line-beginning-position)))
-            (end (save-excursion (goto-char end) (move-end-of-line 1) (point-marker))))
-        (untabify beg end)
+            (end (save-excursion (goto-char end) (move-end-of-line 1) (point-marker)))
+            edits)
+        (when (save-excursion (goto-char beg) (search-forward "\t" end t))
+          (untabify beg end))
         (goto-char beg)
         (while (< (point) end)
           (when (looking-at-p " ")
-            ;; fix spaces at beginning of line:
-            (just-one-space ledger-post-account-alignment-column)
-            ;; fix spaces before amount if any:
-            (when (re-search-forward "\t\\|  \\| \t" (line-end-position) t)
-              (goto-char (match-beginning 0))
-              (let ((acct-end-column (current-column))
-                    (amt-width (ledger-next-amount (line-end-position)))
-                    amt-adjust)
-                (when amt-width
-                  (if (/= 0 (setq amt-adjust (- (if (> (- ledger-post-amount-alignment-column amt-width)
-                                                       (+ 2 acct-end-column))
-                                                    ledger-post-amount-alignment-column ;;we have room
-                                                  (+ acct-end-column 2 amt-width))
-                                                amt-width
-                                                (current-column))))
-                      (if (> amt-adjust 0)
-                          (insert (make-string amt-adjust ? ))
-                        (delete-char amt-adjust)))))))
-          (forward-line 1))))))
+            (let* ((bol (point))
+                   (ws-end (save-excursion (skip-chars-forward " ") (point)))
+                   ;; column shift the pending indentation fix will cause
+                   ;; for the rest of the line
+                   (delta (- ledger-post-account-alignment-column (- ws-end bol))))
+              ;; fix spaces at beginning of line:
+              (unless (zerop delta)
+                (push (list bol ws-end
+                            (make-string ledger-post-account-alignment-column ?\s))
+                      edits))
+              (goto-char ws-end)
+              ;; fix spaces before amount if any:
+              (when (re-search-forward "\t\\|  \\| \t" (line-end-position) t)
+                (goto-char (match-beginning 0))
+                (let ((acct-end-column (+ (current-column) delta))
+                      (amt-width (ledger-next-amount (line-end-position)))
+                      amt-adjust)
+                  (when amt-width
+                    (if (/= 0 (setq amt-adjust (- (if (> (- ledger-post-amount-alignment-column amt-width)
+                                                         (+ 2 acct-end-column))
+                                                      ledger-post-amount-alignment-column ;;we have room
+                                                    (+ acct-end-column 2 amt-width))
+                                                  amt-width
+                                                  (+ (current-column) delta))))
+                        (if (> amt-adjust 0)
+                            (push (list (point) (point) (make-string amt-adjust ?\s))
+                                  edits)
+                          (push (list (+ (point) amt-adjust) (point) "") edits))))))))
+          (forward-line 1))
+        ;; `edits' holds (DEL-BEG DEL-END INSERTION), most recent first;
+        ;; applying back to front keeps earlier positions valid.
+        (dolist (edit edits)
+          (delete-region (nth 0 edit) (nth 1 edit))
+          (goto-char (nth 0 edit))
+          (insert (nth 2 edit)))))))
 
 (defun ledger-indent-line ()
   "Indent the current line."
@@ -136,6 +136,17 @@ no sorting, i.e. using ledger file order."
   :type 'boolean
   :group 'ledger-reconcile)
 
+(defcustom ledger-reconcile-page-size 0
+  "If positive, materialize the reconcile listing this many xacts at a time.
+The remaining transactions are rendered page by page as point
+approaches the end of the listing, so opening an account with
+tens of thousands of uncleared postings does not block while the
+whole buffer is built.  If zero, the entire listing is built up
+front."
+  :type 'integer
+  :group 'ledger-reconcile
+  :package-version '(ledger-mode . "4.0.1"))
+
 ;; s-functions below are copied from Magnars' s.el
 ;; prefix ledger-reconcile- is added to not conflict with s.el
 (defun ledger-reconcile-s-pad-left (len padding s)
@@ -189,18 +200,66 @@ no sorting, i.e. using ledger file order."
     (ledger-split-commodity-string
      (buffer-substring-no-properties (point-min) (point-max)))))
 
+(defvar-local ledger-reconcile--cached-balance nil
+  "Cached cleared-or-pending balance of the account being reconciled.
+A commoditized amount as returned by
+`ledger-split-commodity-string', or nil when the balance must be
+recomputed by the ledger binary.  The cache is kept current by
+applying the amount of each toggled posting locally, so toggling
+postings does not re-parse the whole journal.")
+
+(defun ledger-reconcile--show-balance (pending target)
+  "Display the PENDING balance and its difference from TARGET."
+  (if target
+      (message "Cleared and Pending balance: %s,   Difference from target: %s"
+               (ledger-commodity-to-string pending)
+               (ledger-commodity-to-string (ledger-subtract-commodity target pending)))
+    (message "Pending balance: %s"
+             (ledger-commodity-to-string pending))))
+
 (defun ledger-display-balance ()
   "Display the cleared-or-pending balance.
-And calculate the target-delta of the account being reconciled."
+And calculate the target-delta of the account being reconciled.
+The locally maintained balance is used when it is known;
+otherwise the balance is computed asynchronously and shown when
+ledger finishes, so reconciling is not blocked on large journals."
   (interactive)
-  (let* ((pending (ledger-reconcile-get-cleared-or-pending-balance ledger-buf ledger-acct)))
-    (when pending
-      (if ledger-target
-          (message "Cleared and Pending balance: %s,   Difference from target: %s"
-                   (ledger-commodity-to-string pending)
-                   (ledger-commodity-to-string (ledger-subtract-commodity ledger-target pending)))
-        (message "Pending balance: %s"
-                 (ledger-commodity-to-string pending))))))
+  (let ((recon-buf (current-buffer))
+        (target ledger-target))
+    (if ledger-reconcile--cached-balance
+        (ledger-reconcile--show-balance ledger-reconcile--cached-balance target)
+      (ledger-exec-ledger-async
+       ledger-buf
+       (lambda (output)
+         (let ((pending (ledger-split-commodity-string
+                         (with-current-buffer output
+                           (buffer-substring-no-properties (point-min) (point-max))))))
+           (when pending
+             (when (buffer-live-p recon-buf)
+               (with-current-buffer recon-buf
+                 (setq ledger-reconcile--cached-balance pending)))
+             (ledger-reconcile--show-balance pending target))))
+       "balance" "--real" "--limit" "cleared or pending" "--empty" "--collapse"
+       "--format" "%(scrub(display_total))" ledger-acct))))
+
+(defun ledger-reconcile--apply-toggle-delta (was-counted status)
+  "Update the cached balance after toggling the posting at point.
+WAS-COUNTED is non-nil when the posting contributed to the
+cleared-or-pending balance before the toggle, and STATUS is its
+state afterwards.  Any amount the cache cannot absorb (a nil or
+mixed-commodity amount) simply drops the cache, forcing a full
+recompute on the next display."
+  (when ledger-reconcile--cached-balance
+    (let ((now-counted (and status t)))
+      (unless (eq was-counted now-counted)
+        (condition-case nil
+            (let ((delta (ledger-split-commodity-string
+                          (get-text-property (point) 'amount))))
+              (setq ledger-reconcile--cached-balance
+                    (if now-counted
+                        (ledger-add-commodity ledger-reconcile--cached-balance delta)
+                      (ledger-subtract-commodity ledger-reconcile--cached-balance delta))))
+          (error (setq ledger-reconcile--cached-balance nil)))))))
 
 (defun ledger-is-stdin (file)
   "True if ledger FILE is standard input."
@@ -220,6 +279,10 @@ And calculate the target-delta of the account being reconciled."
   (interactive)
   (beginning-of-line)
   (let ((where (get-text-property (point) 'where))
+        (was-counted (and (memq (get-text-property (point) 'font-lock-face)
+                                '(ledger-font-reconciler-pending-face
+                                  ledger-font-reconciler-cleared-face))
+                          t))
         (inhibit-read-only t)
         status)
     (when (ledger-reconcile-get-buffer where)
@@ -247,24 +310,200 @@ And calculate the target-delta of the account being reconciled."
             (t
              (add-text-properties (line-beginning-position)
                                   (line-end-position)
-                                  (list 'font-lock-face 'ledger-font-reconciler-uncleared-face )))))
+                                  (list 'font-lock-face 'ledger-font-reconciler-uncleared-face ))))
+      (ledger-reconcile--apply-toggle-delta was-counted status))
     (forward-line)
     (beginning-of-line)
     (ledger-display-balance)))
 
+(defun ledger-reconcile-toggle-region (begin end)
+  "Toggle every transaction listed between BEGIN and END.
+The ledger-buffer edits are grouped by source buffer and applied
+in one batched pass at the transaction level, and the balance is
+recomputed once at the end rather than once per line, so clearing
+a whole statement of postings costs a single pass.  Unlike
+`ledger-reconcile-toggle' this never prompts for effective dates."
+  (interactive "r")
+  (let ((style (if ledger-reconcile-toggle-to-pending
+                   'pending
+                 'cleared))
+        (inhibit-read-only t)
+        targets faces)
+    ;; Collect the listing lines in the region and their source
+    ;; locations, grouped by source buffer.
+    (save-excursion
+      (goto-char begin)
+      (beginning-of-line)
+      (while (and (< (point) end) (not (eobp)))
+        (let ((where (get-text-property (point) 'where)))
+          (when (and where (bufferp (car where)))
+            (let ((group (assq (car where) targets)))
+              (unless group
+                (setq group (list (car where)))
+                (push group targets))
+              (push (cons (point-marker) (cdr where)) (cdr group)))))
+        (forward-line 1)))
+    ;; Apply the toggles one source buffer at a time.  Within a buffer
+    ;; the targets are visited in line order with a single moving
+    ;; cursor, the edits collected, and then applied back to front so
+    ;; the collected positions stay valid.
+    (dolist (group targets)
+      (with-current-buffer (car group)
+        (save-excursion
+          (let ((lines (sort (cdr group) (lambda (a b) (< (cdr a) (cdr b)))))
+                (statuses (make-hash-table :test #'eql))
+                (line 1)
+                edits)
+            (goto-char (point-min))
+            (dolist (target lines)
+              (forward-line (- (cdr target) line))
+              (setq line (cdr target))
+              (let* ((start (save-excursion (ledger-navigate-beginning-of-xact)))
+                     (status (gethash start statuses 'miss)))
+                (when (eq status 'miss)
+                  (let ((edit (save-excursion
+                                (goto-char start)
+                                (ledger-toggle--transaction-edit style))))
+                    (when edit
+                      (push edit edits))
+                    (setq status (and edit (nth 3 edit)))
+                    (puthash start status statuses)))
+                (push (cons (car target) status) faces)))
+            (dolist (edit edits)
+              (ledger-toggle--apply-edit edit))))))
+    ;; Reface the listing lines and update the balance once.
+    (save-excursion
+      (dolist (pair faces)
+        (goto-char (car pair))
+        (remove-text-properties (line-beginning-position)
+                                (line-end-position)
+                                (list 'font-lock-face))
+        (add-text-properties (line-beginning-position)
+                             (line-end-position)
+                             (list 'font-lock-face
+                                   (cond ((eq (cdr pair) 'pending)
+                                          'ledger-font-reconciler-pending-face)
+                                         ((eq (cdr pair) 'cleared)
+                                          'ledger-font-reconciler-cleared-face)
+                                         (t
+                                          'ledger-font-reconciler-uncleared-face))))
+        (set-marker (car pair) nil)))
+    (setq ledger-reconcile--cached-balance nil)
+    (ledger-display-balance)))
+
+(defun ledger-reconcile--buffer-lines (buffer)
+  "Return the lines of BUFFER, with text properties, as a list."
+  (with-current-buffer buffer
+    (save-excursion
+      (goto-char (point-min))
+      (let (lines)
+        (while (not (eobp))
+          (let ((beg (point)))
+            (forward-line 1)
+            (push (buffer-substring beg (point)) lines)))
+        (nreverse lines)))))
+
+(defun ledger-reconcile--lines-equal-p (l1 l2)
+  "Compare reconcile listing lines L1 and L2, including their text properties.
+The properties of interest are uniform across a line, so they are
+only compared at the first character."
+  (and (equal l1 l2)
+       (equal (get-text-property 0 'where l1) (get-text-property 0 'where l2))
+       (eq (get-text-property 0 'font-lock-face l1)
+           (get-text-property 0 'font-lock-face l2))
+       (equal (get-text-property 0 'amount l1) (get-text-property 0 'amount l2))))
+
+(defun ledger-reconcile--line-pos (buffer line)
+  "Return the position at the beginning of LINE (zero-based) in BUFFER."
+  (with-current-buffer buffer
+    (save-excursion
+      (goto-char (point-min))
+      (forward-line line)
+      (point))))
+
+(defun ledger-reconcile--patch-buffer (new-buf)
+  "Patch the current buffer so its contents match NEW-BUF.
+Only the span of lines that actually differs is replaced, so
+point, markers and the window start outside that span all
+survive.  Lines are compared including their text properties,
+since a posting's source location can change even when its
+printed text does not."
+  (let* ((old-lines (ledger-reconcile--buffer-lines (current-buffer)))
+         (new-lines (ledger-reconcile--buffer-lines new-buf))
+         (n-old (length old-lines))
+         (n-new (length new-lines))
+         (prefix 0)
+         (suffix 0))
+    (let ((o old-lines) (n new-lines))
+      (while (and o n (ledger-reconcile--lines-equal-p (car o) (car n)))
+        (setq prefix (1+ prefix) o (cdr o) n (cdr n))))
+    (let ((o (reverse (nthcdr prefix old-lines)))
+          (n (reverse (nthcdr prefix new-lines))))
+      (while (and o n (ledger-reconcile--lines-equal-p (car o) (car n)))
+        (setq suffix (1+ suffix) o (cdr o) n (cdr n))))
+    (let ((old-beg (ledger-reconcile--line-pos (current-buffer) prefix))
+          (old-end (ledger-reconcile--line-pos (current-buffer) (- n-old suffix)))
+          (new-beg (ledger-reconcile--line-pos new-buf prefix))
+          (new-end (ledger-reconcile--line-pos new-buf (- n-new suffix))))
+      (unless (and (= old-beg old-end) (= new-beg new-end))
+        (save-excursion
+          (goto-char old-beg)
+          (delete-region old-beg old-end)
+          (insert-buffer-substring new-buf new-beg new-end))))))
+
+;; The pagination state is defined before `ledger-reconcile-refresh',
+;; which let-binds and reads it: under lexical binding the compiler
+;; must have seen the defvars for the let to be dynamic.
+(defvar-local ledger-reconcile--pending-xacts nil
+  "Transactions fetched for the listing but not rendered yet.
+Only non-nil when `ledger-reconcile-page-size' is positive and
+more xacts remain than have been materialized.")
+
+(defvar-local ledger-reconcile--format-fn nil
+  "Compiled line format used when materializing pending xacts.")
+
+(defvar-local ledger-reconcile--realized-count 0
+  "Number of transactions already rendered into the listing.")
+
+(defvar ledger-reconcile--page-floor nil
+  "When bound, minimum number of xacts `ledger-do-reconcile' must render.
+`ledger-reconcile-refresh' binds this to the realized count of the
+displayed listing, so refreshing does not fold already visible
+pages back into the pending set.")
+
 (defun ledger-reconcile-refresh ()
   "Force the reconciliation window to refresh.
-Return the number of uncleared xacts found."
+The new listing is built in a temporary buffer and diffed against
+the displayed one, patching only the lines that changed; point,
+markers and window start are preserved.  Return the number of
+uncleared xacts found."
   (interactive)
   (let ((inhibit-read-only t)
-        (line (count-lines (point-min) (point))))
-    (erase-buffer)
-    (prog1
-        (ledger-do-reconcile ledger-reconcile-sort-key)
-      (set-buffer-modified-p t)
-      (ledger-reconcile-ensure-xacts-visible)
-      (goto-char (point-min))
-      (forward-line line))))
+        (buf ledger-buf)
+        (acct ledger-acct)
+        (realized ledger-reconcile--realized-count)
+        (temp (generate-new-buffer " *Reconcile-refresh*"))
+        count)
+    (setq ledger-reconcile--cached-balance nil)
+    (unwind-protect
+        (progn
+          (with-current-buffer temp
+            (let ((ledger-buf buf)
+                  (ledger-acct acct)
+                  (ledger-reconcile--page-floor realized))
+              (setq count (ledger-do-reconcile ledger-reconcile-sort-key))))
+          (ledger-reconcile--patch-buffer temp)
+          (setq ledger-reconcile--pending-xacts
+                (buffer-local-value 'ledger-reconcile--pending-xacts temp)
+                ledger-reconcile--format-fn
+                (buffer-local-value 'ledger-reconcile--format-fn temp)
+                ledger-reconcile--realized-count
+                (buffer-local-value 'ledger-reconcile--realized-count temp)))
+      (kill-buffer temp))
+    (set-buffer-modified-p t)
+    (setq buffer-read-only t)
+    (ledger-reconcile-ensure-xacts-visible)
+    count))
 
 (defun ledger-reconcile-refresh-after-save ()
   "Refresh the recon-window after the ledger buffer is saved."
@@ -420,13 +659,16 @@ POSTING is used in `ledger-clear-whole-transactions' is nil."
       (if (eq status 'pending)
           (set-text-properties beg (1- (point))
                                (list 'font-lock-face 'ledger-font-reconciler-pending-face
-                                     'where where))
+                                     'where where
+                                     'amount amount))
         (set-text-properties beg (1- (point))
                              (list 'font-lock-face 'ledger-font-reconciler-cleared-face
-                                   'where where)))
+                                   'where where
+                                   'amount amount)))
     (set-text-properties beg (1- (point))
                          (list 'font-lock-face 'ledger-font-reconciler-uncleared-face
-                               'where where))))
+                               'where where
+                               'amount amount))))
 
 (defun ledger-reconcile-format-xact (xact fmt)
   "Format XACT using FMT."
@@ -447,9 +689,157 @@ POSTING is used in `ledger-clear-whole-transactions' is nil."
                                         ledger-reconcile-buffer-account-max-chars)
                                        (nth 2 posting)))))  ; amount
 
+(defun ledger-reconcile--insert-xacts (xacts count fmt)
+  "Insert up to COUNT entries from XACTS at point, formatted with FMT.
+Return the list of entries left over."
+  (while (and xacts (> count 0))
+    (ledger-reconcile-format-xact (car xacts) fmt)
+    (setq xacts (cdr xacts)
+          count (1- count)))
+  xacts)
+
+(defun ledger-reconcile--more-line (remaining)
+  "Return the trailer line announcing REMAINING unrendered entries."
+  (format "(%d more entries; move point to the end of the listing to show them)"
+          (length remaining)))
+
+(defun ledger-reconcile--extend-listing ()
+  "Materialize the next page of pending xacts when point nears the end.
+Run from `post-command-hook' in the reconcile buffer."
+  (when (and ledger-reconcile--pending-xacts
+             (> (point) (- (point-max) 1000)))
+    (let ((inhibit-read-only t))
+      (save-excursion
+        (goto-char (point-max))
+        (forward-line 0)
+        ;; replace the trailer line with the next page
+        (delete-region (point) (point-max))
+        (let ((remaining (ledger-reconcile--insert-xacts
+                          ledger-reconcile--pending-xacts
+                          ledger-reconcile-page-size
+                          ledger-reconcile--format-fn)))
+          (setq ledger-reconcile--realized-count
+                (+ ledger-reconcile--realized-count
+                   (- (length ledger-reconcile--pending-xacts)
+                      (length remaining)))
+                ledger-reconcile--pending-xacts remaining)
+          (if remaining
+              (insert (ledger-reconcile--more-line remaining))
+            (delete-char -1))))
+      (set-buffer-modified-p nil))))
+
+(defun ledger-reconcile--realize-pending ()
+  "Materialize every pending page of the listing at once."
+  (when ledger-reconcile--pending-xacts
+    (let ((inhibit-read-only t))
+      (save-excursion
+        (goto-char (point-max))
+        (forward-line 0)
+        ;; replace the trailer line with everything that is left
+        (delete-region (point) (point-max))
+        (ledger-reconcile--insert-xacts ledger-reconcile--pending-xacts
+                                        (length ledger-reconcile--pending-xacts)
+                                        ledger-reconcile--format-fn)
+        (setq ledger-reconcile--realized-count
+              (+ ledger-reconcile--realized-count
+                 (length ledger-reconcile--pending-xacts))
+              ledger-reconcile--pending-xacts nil)
+        (delete-char -1))
+      (set-buffer-modified-p nil))))
+
+(defvar-local ledger-reconcile--amount-index nil
+  "Hash table from absolute amount value to listing line positions.
+Built lazily by `ledger-reconcile--ensure-amount-index' for
+`ledger-reconcile-find-amount'.")
+
+(defvar-local ledger-reconcile--amount-index-tick nil
+  "Value of `buffer-chars-modified-tick' the amount index is valid for.
+Toggling only changes text properties, which this tick ignores,
+so the index survives marking postings and is rebuilt only when
+the listing text itself changes.")
+
+(defun ledger-reconcile--amount-value (amount)
+  "Return the numeric value of the printed AMOUNT string, or nil."
+  (let ((parsed (ignore-errors (ledger-split-commodity-string amount))))
+    (and parsed (numberp (car parsed)) (car parsed))))
+
+(defun ledger-reconcile--ensure-amount-index ()
+  "Return the amount index of the listing, building it when stale.
+Any pages still pending are materialized first, so the index
+covers every posting of the account."
+  (ledger-reconcile--realize-pending)
+  (let ((tick (buffer-chars-modified-tick)))
+    (unless (and ledger-reconcile--amount-index
+                 (eq tick ledger-reconcile--amount-index-tick))
+      (let ((index (make-hash-table :test #'equal)))
+        (save-excursion
+          (goto-char (point-min))
+          (while (not (eobp))
+            (let ((amount (and (get-text-property (point) 'where)
+                               (get-text-property (point) 'amount))))
+              (when amount
+                (let ((value (ledger-reconcile--amount-value amount)))
+                  (when value
+                    (push (point) (gethash (abs value) index))))))
+            (forward-line 1)))
+        (maphash (lambda (key positions)
+                   (puthash key (nreverse positions) index))
+                 index)
+        (setq ledger-reconcile--amount-index index
+              ledger-reconcile--amount-index-tick tick))))
+  ledger-reconcile--amount-index)
+
+(defun ledger-reconcile--input-amount (input)
+  "Extract the amount from INPUT, a bare amount or a statement line.
+The last number in INPUT is parsed with
+`ledger-split-commodity-string'; return its value or nil."
+  (let ((start 0) last)
+    (while (string-match "-?[0-9]\\(?:[0-9.,]*[0-9]\\)?" input start)
+      (setq last (match-string 0 input)
+            start (match-end 0)))
+    (and last (ledger-reconcile--amount-value last))))
+
+(defun ledger-reconcile-find-amount (input &optional mark)
+  "Jump to the next listing line whose amount matches INPUT.
+INPUT may be a bare amount or a whole pasted statement line; the
+last number in it is used and its sign is ignored, since
+statements quote magnitudes.  Uncleared candidates are preferred
+and repeated invocations cycle through them.  With a prefix
+argument MARK, toggle the match immediately when it is the only
+uncleared one."
+  (interactive (list (read-string "Amount or statement line: ")
+                     current-prefix-arg))
+  (let ((value (ledger-reconcile--input-amount input)))
+    (unless value
+      (user-error "No amount found in %S" input))
+    (let* ((candidates (gethash (abs value)
+                                (ledger-reconcile--ensure-amount-index)))
+           (uncleared (cl-remove-if-not
+                       (lambda (pos)
+                         (eq (get-text-property pos 'font-lock-face)
+                             'ledger-font-reconciler-uncleared-face))
+                       candidates))
+           (pool (or uncleared candidates)))
+      (unless pool
+        (user-error "No posting with amount %s in the listing" input))
+      (goto-char (or (cl-find-if (lambda (pos) (> pos (line-beginning-position)))
+                                 pool)
+                     (car pool)))
+      (cond ((and mark uncleared (null (cdr uncleared)))
+             (ledger-reconcile-toggle))
+            ((cdr pool)
+             (message "%d matching postings (%d uncleared); repeat to cycle"
+                      (length candidates) (length uncleared)))
+            ((null uncleared)
+             (message "Only match is already marked"))))))
+
 (defun ledger-do-reconcile (&optional sort)
   "SORT the uncleared transactions in the account and display them in the *Reconcile* buffer.
-Return a count of the uncleared transactions."
+Return a count of the uncleared transactions.  When
+`ledger-reconcile-page-size' is positive, only the first page is
+rendered here; the rest is kept in
+`ledger-reconcile--pending-xacts' and materialized by
+`ledger-reconcile--extend-listing' as point approaches the end."
   (let* ((buf ledger-buf)
          (account ledger-acct)
          (sort-by (if sort
@@ -464,14 +854,25 @@ Return a count of the uncleared transactions."
               (if (looking-at "(")
                   (read (current-buffer))))))
          (fmt (ledger-reconcile-compile-format-string ledger-reconcile-buffer-line-format)))
+    (setq ledger-reconcile--format-fn fmt
+          ledger-reconcile--pending-xacts nil
+          ledger-reconcile--realized-count 0)
     (if (> (length xacts) 0)
         (progn
           (if ledger-reconcile-buffer-header
               (insert (format ledger-reconcile-buffer-header account)))
-          (dolist (xact xacts)
-            (ledger-reconcile-format-xact xact fmt))
-          (goto-char (point-max))
-          (delete-char -1)) ;gets rid of the extra line feed at the bottom of the list
+          (let* ((page (if (> ledger-reconcile-page-size 0)
+                           (max ledger-reconcile-page-size
+                                (or ledger-reconcile--page-floor 0))
+                         (length xacts)))
+                 (remaining (ledger-reconcile--insert-xacts xacts page fmt)))
+            (setq ledger-reconcile--pending-xacts remaining
+                  ledger-reconcile--realized-count (- (length xacts)
+                                                      (length remaining)))
+            (if remaining
+                (insert (ledger-reconcile--more-line remaining))
+              (goto-char (point-max))
+              (delete-char -1)))) ;gets rid of the extra line feed at the bottom of the list
       (insert (concat "There are no uncleared entries for " account)))
     (goto-char (point-min))
     (set-buffer-modified-p nil)
@@ -587,6 +988,7 @@ moved and recentered.  If they aren't strange things happen."
     (define-key map [? ] #'ledger-reconcile-toggle)
     (define-key map [?a] #'ledger-reconcile-add)
     (define-key map [?d] #'ledger-reconcile-delete)
+    (define-key map [?f] #'ledger-reconcile-find-amount)
     (define-key map [?g] #'ledger-reconcile);
     (define-key map [?n] #'next-line)
     (define-key map [?p] #'previous-line)
@@ -623,6 +1025,7 @@ moved and recentered.  If they aren't strange things happen."
     ["Sort by file order" ,(ledger-reconcile-change-sort-key-and-refresh "(0)")]
     "---"
     ["Toggle Entry" ledger-reconcile-toggle]
+    ["Find Amount" ledger-reconcile-find-amount]
     ["Add Entry" ledger-reconcile-add]
     ["Delete Entry" ledger-reconcile-delete]
     "---"
@@ -634,7 +1037,8 @@ moved and recentered.  If they aren't strange things happen."
     ))
 
 (define-derived-mode ledger-reconcile-mode text-mode "Reconcile"
-  "A mode for reconciling ledger entries.")
+  "A mode for reconciling ledger entries."
+  (add-hook 'post-command-hook #'ledger-reconcile--extend-listing nil t))
 
 (provide 'ledger-reconcile)
 
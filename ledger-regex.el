@@ -64,28 +64,33 @@
 (defconst ledger-init-string-regex
   "^--.+?\\($\\|[ ]\\)")
 
-(defconst ledger-account-name-regex
-  "\\(?1:[^][(); \t\r\n]+\\(?: [^][(); \t\r\n]+\\)*\\)")
+;; The account regexes are built from each other, so they live in
+;; `eval-and-compile': the finished values are then also available at
+;; byte-compile time, where `eval-when-compile' forms can fold them
+;; into literals.
+(eval-and-compile
+  (defconst ledger-account-name-regex
+    "\\(?1:[^][(); \t\r\n]+\\(?: [^][(); \t\r\n]+\\)*\\)")
 
-(defconst ledger-account-directive-regex
-  (concat "^account[ \t]+" ledger-account-name-regex))
+  (defconst ledger-account-directive-regex
+    (concat "^account[ \t]+" ledger-account-name-regex))
 
-(defconst ledger-account-name-maybe-virtual-regex
-  (concat "[[(]?" ledger-account-name-regex "[])]?"))
+  (defconst ledger-account-name-maybe-virtual-regex
+    (concat "[[(]?" ledger-account-name-regex "[])]?"))
 
-(defconst ledger-account-any-status-regex
-  (concat "^[ \t]+\\(?:[!*][ \t]*\\)?" ledger-account-name-maybe-virtual-regex))
+  (defconst ledger-account-any-status-regex
+    (concat "^[ \t]+\\(?:[!*][ \t]*\\)?" ledger-account-name-maybe-virtual-regex))
 
-;; This would incorrectly match "account (foo)", but writing the regexp this way
-;; allows us to have just one match result
-(defconst ledger-account-name-or-directive-regex
-  (format "\\(?:%s\\|%s\\)" ledger-account-any-status-regex ledger-account-directive-regex))
+  ;; This would incorrectly match "account (foo)", but writing the regexp this way
+  ;; allows us to have just one match result
+  (defconst ledger-account-name-or-directive-regex
+    (format "\\(?:%s\\|%s\\)" ledger-account-any-status-regex ledger-account-directive-regex))
 
-(defconst ledger-account-pending-regex
-  (concat "\\(^[ \t]+\\)!" ledger-account-name-maybe-virtual-regex))
+  (defconst ledger-account-pending-regex
+    (concat "\\(^[ \t]+\\)!" ledger-account-name-maybe-virtual-regex))
 
-(defconst ledger-account-cleared-regex
-  (concat "\\(^[ \t]+\\)*" ledger-account-name-maybe-virtual-regex))
+  (defconst ledger-account-cleared-regex
+    (concat "\\(^[ \t]+\\)*" ledger-account-name-maybe-virtual-regex)))
 
 (defmacro ledger-define-regexp (name regex docs &rest args)
   "Simplify the creation of a Ledger regex and helper functions."
@@ -344,19 +349,20 @@
   (note end-note))
 
 (defconst ledger-amount-regex
-  (concat "\\(  \\|\t\\| \t\\)[ \t]*-?"
-          "\\(?:" ledger-commodity-regexp " *\\)?"
-          ;; We either match just a number after the commodity with no
-          ;; decimal or thousand separators or a number with thousand
-          ;; separators.  If we have a decimal part starting with `,'
-          ;; or `.', because the match is non-greedy, it must leave at
-          ;; least one of those symbols for the following capture
-          ;; group, which then finishes the decimal part.
-          "\\(-?\\(?:[0-9]+\\|[0-9,.]+?\\)\\)"
-          "\\([,.][0-9)]+\\)?"
-          "\\(?: *" ledger-commodity-regexp "\\)?"
-          "\\([ \t]*[@={]@?[^\n;]+?\\)?"
-          "\\([ \t]+;.+?\\|[ \t]*\\)?$"))
+  (eval-when-compile
+    (concat "\\(  \\|\t\\| \t\\)[ \t]*-?"
+            "\\(?:" ledger-commodity-regexp " *\\)?"
+            ;; We either match just a number after the commodity with no
+            ;; decimal or thousand separators or a number with thousand
+            ;; separators.  If we have a decimal part starting with `,'
+            ;; or `.', because the match is non-greedy, it must leave at
+            ;; least one of those symbols for the following capture
+            ;; group, which then finishes the decimal part.
+            "\\(-?\\(?:[0-9]+\\|[0-9,.]+?\\)\\)"
+            "\\([,.][0-9)]+\\)?"
+            "\\(?: *" ledger-commodity-regexp "\\)?"
+            "\\([ \t]*[@={]@?[^\n;]+?\\)?"
+            "\\([ \t]+;.+?\\|[ \t]*\\)?$")))
 
 (ledger-define-regexp year
   (rx (group (+ (any "0-9"))))
@@ -389,31 +395,64 @@
   "\\(?:\\([0-9]\\{1,2\\}\\)[-/]\\)?\\([0-9]\\{1,2\\}\\)")
 
 (defconst ledger-xact-start-regex
-  (concat "^" ledger-iso-date-regexp  ;; subexp 1
-          "\\(=" ledger-iso-date-regexp "\\)?"
-          ))
+  (eval-when-compile
+    (concat "^" ledger-iso-date-regexp  ;; subexp 1
+            "\\(=" ledger-iso-date-regexp "\\)?"
+            )))
 
 (defconst ledger-xact-after-date-regex
-  (concat "\\(?:[ \t]+\\([*!]\\)\\)?"  ;; mark, subexp 1
-          "\\(?:[ \t]+\\((.*?)\\)\\)?"  ;; code, subexp 2
-          "\\(?:[ \t]+\\(.+?\\)\\)?"   ;; desc, subexp 3
-          "\\(?:\\(?:\t\\|[ \t]\\{2,\\}\\)\\(;[^\n]*\\)\\)?$" ;; comment, subexp 4
-          ))
+  (eval-when-compile
+    (concat "\\(?:[ \t]+\\([*!]\\)\\)?"  ;; mark, subexp 1
+            "\\(?:[ \t]+\\((.*?)\\)\\)?"  ;; code, subexp 2
+            "\\(?:[ \t]+\\(.+?\\)\\)?"   ;; desc, subexp 3
+            "\\(?:\\(?:\t\\|[ \t]\\{2,\\}\\)\\(;[^\n]*\\)\\)?$" ;; comment, subexp 4
+            )))
 
 (defconst ledger-posting-regex
-  (concat "^[[:blank:]]+"                 ; initial white space
-          "\\(\\([*!]\\)?"                ; state and account 1, state 2
-          "[[:blank:]]*\\(.*?\\)\\)?"     ; account 3
-          "\\(?:\t\\|[[:blank:]]\\{2,\\}" ; column separator
-          "\\([^;\n]*?\\)"                ; amount 4
-          "[[:blank:]]*\\(;.*\\)?\\)?$"   ; comment 5
-          ))
+  (eval-when-compile
+    (concat "^[[:blank:]]+"                 ; initial white space
+            "\\(\\([*!]\\)?"                ; state and account 1, state 2
+            "[[:blank:]]*\\(.*?\\)\\)?"     ; account 3
+            "\\(?:\t\\|[[:blank:]]\\{2,\\}" ; column separator
+            "\\([^;\n]*?\\)"                ; amount 4
+            "[[:blank:]]*\\(;.*\\)?\\)?$"   ; comment 5
+            )))
 
 
 
 (defconst ledger-directive-start-regex
   "[=~;#%|\\*[A-Za-z]")
 
+(defun ledger-regex--group-count (regexp)
+  "Return the number of capturing groups in REGEXP.
+Counts plain as well as explicitly numbered groups;
+`regexp-opt-depth' skips the numbered ones."
+  (save-match-data
+    (let ((count 0)
+          (start 0))
+      (while (string-match "\\\\(\\(\\?[0-9]*:\\)?" regexp start)
+        (setq start (match-end 0))
+        ;; Skip only shy groups, i.e. a bare "?:" suffix.
+        (unless (and (match-beginning 1)
+                     (= 2 (- (match-end 1) (match-beginning 1))))
+          (setq count (1+ count))))
+      count)))
+
+;; Callers throughout ledger-mode hard-code sub-group numbers into
+;; `match-string' calls against these patterns.  Verify the group
+;; counts once, when the library is loaded, so that regrouping one of
+;; the building blocks above fails immediately instead of producing
+;; silently shifted matches.
+(dolist (spec '((ledger-iso-date-regexp . 4)
+                (ledger-payee-any-status-regex . 4)
+                (ledger-account-any-status-regex . 1)
+                (ledger-amount-regex . 7)
+                (ledger-xact-after-date-regex . 4)
+                (ledger-posting-regex . 5)))
+  (let ((count (ledger-regex--group-count (symbol-value (car spec)))))
+    (unless (= count (cdr spec))
+      (error "%s has %d groups; callers expect %d"
+             (car spec) count (cdr spec)))))
 
 (provide 'ledger-regex)
 
@@ -25,9 +25,11 @@
 
 ;;; Code:
 
+(require 'cl-lib)
 (require 'ledger-xact)
 (require 'ledger-navigate)
 (require 'ledger-commodities)
+(require 'ledger-complete)
 (declare-function ledger-read-string-with-default "ledger-mode" (prompt default))
 (declare-function ledger-read-account-with-prompt "ledger-mode" (prompt))
 
@@ -297,9 +299,10 @@ used to generate the buffer, navigating the buffer, etc."
         (set (make-local-variable 'ledger-report-is-reversed) nil)
         (set (make-local-variable 'ledger-report-current-month) nil)
         (set 'ledger-master-file file)
-        (ledger-do-report (ledger-report-cmd report-name edit)))
-      (ledger-report-maybe-shrink-window)
-      (run-hooks 'ledger-report-after-report-hook)
+        (ledger-do-report (ledger-report-cmd report-name edit)
+                          (lambda ()
+                            (ledger-report--shrink-window)
+                            (run-hooks 'ledger-report-after-report-hook))))
       (message (substitute-command-keys (concat "\\[ledger-report-quit] to quit; "
                                                 "\\[ledger-report-redo] to redo; "
                                                 "\\[ledger-report-edit-report] to edit; "
@@ -493,9 +496,10 @@ Optionally EDIT the command."
     (ledger-report-cmd ledger-report-name nil)
     (ledger-report-redo)))
 
-(defun ledger-report--add-links ()
-  "Replace file and line annotations with buttons."
-  (while (re-search-forward "^\\(\\(?:/\\|[a-zA-Z]:[\\/]\\)[^:]+\\)?:\\([0-9]+\\)?:" nil t)
+(defun ledger-report--add-links (&optional end)
+  "Replace file and line annotations with buttons.
+When END is non-nil, only process annotations before it."
+  (while (re-search-forward "^\\(\\(?:/\\|[a-zA-Z]:[\\/]\\)[^:]+\\)?:\\([0-9]+\\)?:" end t)
     (let ((file (match-string 1))
           (line (string-to-number (match-string 2))))
       (delete-region (match-beginning 0) (match-end 0))
@@ -516,34 +520,199 @@ Optionally EDIT the command."
   (let ((ledger-report-cmd cmd))
     (funcall ledger-report-header-line-fn)))
 
-(defun ledger-do-report (cmd)
+(defcustom ledger-report-cache-limit 8
+  "Number of rendered reports kept for replay without rerunning ledger.
+A report is replayed when the same expanded command line is
+requested again and none of the journal files changed in the
+meantime.  Set to 0 to disable the cache."
+  :type 'integer
+  :package-version '(ledger-mode . "4.0.1")
+  :group 'ledger-report)
+
+(defvar ledger-report--output-cache nil
+  "Alist from an expanded command line to (STATE . CONTENT).
+STATE is the journal state token the report was rendered against
+and CONTENT the rendered report body, properties included.  The
+inline Report:/Command: header is not part of CONTENT; its
+separator is sized to the window and must be emitted fresh.
+Most recently used entries come first.")
+
+(defvar-local ledger-report--cache-key nil
+  "Expanded command line the running report will be cached under, or nil.")
+
+(defvar-local ledger-report--cache-state nil
+  "Journal state token captured when the running report was started.")
+
+(defvar-local ledger-report--content-start nil
+  "Position where the report body starts, after any inline header.
+Only the text from here on is cached.")
+
+(defun ledger-report--journal-state ()
+  "Return a token identifying the current content of the journal files.
+The token pairs each file of the include graph with its
+modification time.  Return nil when the journal buffer has
+unsaved changes, in which case the report must not be cached."
+  (when (buffer-live-p ledger-buf)
+    (with-current-buffer ledger-buf
+      (unless (buffer-modified-p)
+        (mapcar (lambda (file)
+                  (cons file (file-attribute-modification-time
+                              (file-attributes file))))
+                (ledger-complete-journal-files))))))
+
+(defun ledger-report--cache-store ()
+  "Remember the rendered report under `ledger-report--cache-key'."
+  (when (and ledger-report--cache-key
+             ledger-report--cache-state
+             (> ledger-report-cache-limit 0))
+    (setq ledger-report--output-cache
+          (cons (cons ledger-report--cache-key
+                      (cons ledger-report--cache-state
+                            (buffer-substring
+                             (or ledger-report--content-start (point-min))
+                             (point-max))))
+                (cl-delete ledger-report--cache-key ledger-report--output-cache
+                           :key #'car :test #'equal)))
+    (let ((tail (nthcdr (1- ledger-report-cache-limit)
+                        ledger-report--output-cache)))
+      (when tail
+        (setcdr tail nil)))))
+
+(defvar-local ledger-report--process nil
+  "The process streaming output into the current report buffer, if any.")
+
+(defvar-local ledger-report--cmd nil
+  "The command line of the report currently being streamed.")
+
+(defvar-local ledger-report--on-done nil
+  "Function called once the streamed report has been fully rendered.")
+
+(defvar-local ledger-report--render-start nil
+  "Marker at the start of the not-yet-rendered report output.
+Everything before it has had native highlighting applied and
+register links added; everything between it and the process mark
+is raw output awaiting its turn.")
+
+(defun ledger-do-report (cmd &optional on-done)
   "Run a report command line CMD.
 CMD may contain a (shell-quoted) version of
 `ledger-report--extra-args-marker', which will be replaced by
-arguments returned by `ledger-report--compute-extra-args'."
+arguments returned by `ledger-report--compute-extra-args'.
+
+The report process runs asynchronously and its output is streamed
+into the current buffer as it arrives, so the first screenful is
+visible while the tail of a large report is still being produced.
+ON-DONE, if non-nil, is called with the report buffer current
+once the whole report has been rendered.
+
+When the same expanded command line was rendered before and none
+of the journal files changed since, the output is replayed from
+`ledger-report--output-cache' without running ledger at all."
   (goto-char (point-min))
   (let* ((marker ledger-report--extra-args-marker)
          (marker-re (concat " *" (regexp-quote marker)))
          (args (ledger-report--compute-extra-args cmd))
          (args-str (concat " " (mapconcat #'shell-quote-argument args " ")))
          (clean-cmd (replace-regexp-in-string marker-re "" cmd t t))
-         (real-cmd (replace-regexp-in-string marker-re args-str cmd t t)))
+         (real-cmd (replace-regexp-in-string marker-re args-str cmd t t))
+         (state (and (> ledger-report-cache-limit 0)
+                     (ledger-report--journal-state)))
+         (cached (and state (assoc real-cmd ledger-report--output-cache))))
     (setq header-line-format
           (and ledger-report-use-header-line
                `(:eval (ledger-report--compute-header-line ,clean-cmd))))
+    (when (and ledger-report--process (process-live-p ledger-report--process))
+      (set-process-sentinel ledger-report--process #'ignore)
+      (delete-process ledger-report--process)
+      (setq ledger-report--process nil))
+    ;; The header's separator line is sized to the current window, so
+    ;; it is emitted fresh here on cache replays as well.
     (unless ledger-report-use-header-line
       (insert (format "Report: %s\n" ledger-report-name)
               (format "Command: %s\n" clean-cmd)
               (make-string (- (window-width) 1) ?=)
               "\n\n"))
-    (let* ((report (shell-command-to-string real-cmd)))
+    (if (and cached (equal state (cadr cached)))
+        (progn
+          ;; bump the entry to the front of the LRU list and replay it
+          (setq ledger-report--output-cache
+                (cons cached (cl-delete cached ledger-report--output-cache
+                                        :test #'eq)))
+          (insert (cddr cached))
+          (when on-done (funcall on-done)))
+      (setq ledger-report--cmd cmd
+            ledger-report--cache-key real-cmd
+            ledger-report--cache-state state
+            ledger-report--on-done on-done
+            ledger-report--content-start (point)
+            ledger-report--render-start (copy-marker (point))
+            ansi-color-context-region nil)
+      (let ((process (start-process-shell-command
+                      "ledger-report" (current-buffer) real-cmd)))
+        (setq ledger-report--process process)
+        (set-process-query-on-exit-flag process nil)
+        (set-marker (process-mark process) (point))
+        (set-process-filter process #'ledger-report--process-filter)
+        (set-process-sentinel process #'ledger-report--process-sentinel)))))
+
+(defun ledger-report--render-new-output (process &optional final)
+  "Render the report output PROCESS has delivered so far.
+Rendering stops at the last complete line unless FINAL is
+non-nil, so partial escape sequences and annotations are left for
+the next chunk."
+  (let ((end (copy-marker (if final
+                              (point-max)
+                            (save-excursion
+                              (goto-char (process-mark process))
+                              (line-beginning-position))))))
+    (when (> end ledger-report--render-start)
       (when ledger-report-use-native-highlighting
-        (setq report (ansi-color-apply report)))
-      (save-excursion
-        (insert report))
-      (when (ledger-report--cmd-needs-links-p cmd)
+        (ansi-color-apply-on-region ledger-report--render-start end))
+      (when (ledger-report--cmd-needs-links-p ledger-report--cmd)
         (save-excursion
-          (ledger-report--add-links))))))
+          (goto-char ledger-report--render-start)
+          (ledger-report--add-links end)))
+      (set-marker ledger-report--render-start (marker-position end)))
+    (set-marker end nil)))
+
+(defun ledger-report--process-filter (process chunk)
+  "Insert CHUNK of report output from PROCESS and render it."
+  (let ((buf (process-buffer process)))
+    (when (buffer-live-p buf)
+      (with-current-buffer buf
+        (let ((inhibit-read-only t))
+          (with-silent-modifications
+            (save-excursion
+              (goto-char (process-mark process))
+              (insert chunk)
+              (set-marker (process-mark process) (point)))
+            (ledger-report--render-new-output process)))))))
+
+(defun ledger-report--process-sentinel (process _event)
+  "Finish rendering once the report PROCESS terminates."
+  (when (memq (process-status process) '(exit signal))
+    (let ((buf (process-buffer process)))
+      (when (buffer-live-p buf)
+        (with-current-buffer buf
+          (let ((inhibit-read-only t))
+            (with-silent-modifications
+              (ledger-report--render-new-output process t)))
+          (when (eq process ledger-report--process)
+            (setq ledger-report--process nil)
+            ;; A failed run leaves error output in the buffer; don't
+            ;; let it be replayed as a report.
+            (when (zerop (process-exit-status process))
+              (ledger-report--cache-store))
+            (let ((on-done ledger-report--on-done))
+              (setq ledger-report--on-done nil)
+              (when on-done (funcall on-done)))))))))
+
+(defun ledger-report--shrink-window ()
+  "Shrink the window showing the current report buffer, if any."
+  (let ((window (get-buffer-window (current-buffer))))
+    (when window
+      (with-selected-window window
+        (ledger-report-maybe-shrink-window)))))
 
 (defun ledger-report-visit-source ()
   "Visit the transaction under point in the report window."
@@ -583,12 +752,14 @@ IGNORE-AUTO and NOCONFIRM are for compatibility with
       (setq ledger-report-cursor-line-number (line-number-at-pos))
       (with-silent-modifications
         (erase-buffer)
-        (ledger-do-report ledger-report-cmd)
-        (when ledger-report-is-reversed
-          (ledger-report-reverse-lines))
-        (when ledger-report-auto-refresh-sticky-cursor
-          (forward-line (- ledger-report-cursor-line-number 5))))
-      (run-hooks 'ledger-report-after-report-hook)
+        (ledger-do-report ledger-report-cmd
+                          (lambda ()
+                            (when ledger-report-is-reversed
+                              (ledger-report-reverse-lines))
+                            (when ledger-report-auto-refresh-sticky-cursor
+                              (forward-line (- ledger-report-cursor-line-number 5)))
+                            (ledger-report--shrink-window)
+                            (run-hooks 'ledger-report-after-report-hook))))
       (pop-to-buffer cur-buf))))
 
 (defun ledger-report-quit ()
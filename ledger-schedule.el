@@ -149,32 +149,91 @@ For example every second Friday, regardless of month."
 
 
 
+(defvar ledger-schedule--candidate-cache nil
+  "Alist of (FILE MTIME CANDIDATES) for already scanned schedule files.
+CANDIDATES holds the byte-compiled entries returned by
+`ledger-schedule-scan-transactions'.")
+
 (defun ledger-schedule-scan-transactions (schedule-file)
   "Scan SCHEDULE-FILE and return a list of transactions with date predicates.
 The car of each item is a function of date that returns true if
-the transaction should be logged for that day."
+the transaction should be logged for that day.  The predicates
+are byte-compiled once per descriptor and the whole result is
+cached against the file's modification time, so reopening the
+schedule does not re-parse an unchanged file."
   (interactive "fFile name: ")
+  (let* ((file (expand-file-name schedule-file))
+         (mtime (file-attribute-modification-time (file-attributes file)))
+         (file-buffer (get-file-buffer file))
+         (modified (and file-buffer (buffer-modified-p file-buffer)))
+         (cached (assoc file ledger-schedule--candidate-cache)))
+    (if (and cached
+             (equal mtime (nth 1 cached))
+             (not modified))
+        (nth 2 cached)
+      (let ((xact-list (ledger-schedule--scan-file file)))
+        ;; A scan of a modified buffer reflects unsaved edits; caching
+        ;; it against the on-disk mtime would keep serving those edits
+        ;; after the buffer is reverted or killed without saving.
+        (unless modified
+          (setq ledger-schedule--candidate-cache
+                (cons (list file mtime xact-list)
+                      (cl-delete file ledger-schedule--candidate-cache
+                                 :key #'car :test #'equal))))
+        xact-list))))
+
+(defun ledger-schedule--scan-file (schedule-file)
+  "Parse SCHEDULE-FILE into a list of candidate entries.
+Each entry has the form (PREDICATE XACT-TEXT YEARS) where
+PREDICATE is a byte-compiled function of a date and YEARS is the
+list of years the descriptor can match, or nil when unbounded."
   (let ((xact-list (list)))
     (with-current-buffer
         (find-file-noselect schedule-file)
       (goto-char (point-min))
       (while (re-search-forward "^\\[\\(.*\\)\\] " nil t)
-        (let ((date-descriptor "")
-              (transaction nil)
-              (xact-start (match-end 0)))
-          (setq date-descriptor
-                (ledger-schedule-read-descriptor-tree
-                 (buffer-substring-no-properties
-                  (match-beginning 0)
-                  (match-end 0))))
+        (let* ((descriptor-string (buffer-substring-no-properties
+                                   (match-beginning 0)
+                                   (match-end 0)))
+               (transaction nil)
+               (xact-start (match-end 0))
+               (date-descriptor
+                (byte-compile
+                 (ledger-schedule-read-descriptor-tree descriptor-string))))
           (forward-paragraph)
           (setq transaction (list date-descriptor
                                   (buffer-substring-no-properties
                                    xact-start
-                                   (point))))
+                                   (point))
+                                  (ledger-schedule--descriptor-years
+                                   descriptor-string)))
           (setq xact-list (cons transaction xact-list))))
       xact-list)))
 
+(defun ledger-schedule--descriptor-years (descriptor-string)
+  "Return the years DESCRIPTOR-STRING can match, or nil if unbounded.
+A clause is bounded when its year field is a plain year list and
+its day field does not override the year constraint; if any
+clause is unbounded, so is the whole descriptor."
+  (catch 'unbounded
+    (let (years)
+      (dolist (clause (split-string
+                       (substring descriptor-string 1
+                                  (string-match "]" descriptor-string))
+                       " " t))
+        (let* ((fields (split-string clause "[/\\-]" t))
+               (year-desc (nth 0 fields))
+               (day-desc (nth 2 fields)))
+          (if (or (null day-desc)
+                  (string-match "[A-Za-z]" day-desc) ; day overrides the year
+                  (string= year-desc "*")
+                  (= 0 (string-to-number year-desc)))
+              (throw 'unbounded nil)
+            (setq years (append (mapcar #'string-to-number
+                                        (split-string year-desc ","))
+                                years)))))
+      years)))
+
 (defun ledger-schedule-read-descriptor-tree (descriptor-string)
   "Read DESCRIPTOR-STRING and return a form that evaluates dates."
   (ledger-schedule-transform-auto-tree
@@ -278,9 +337,22 @@ date descriptor."
         (ledger-schedule-constrain-day-in-month count day-of-week)))))
 
 (defun ledger-schedule-list-upcoming-xacts (candidate-items early horizon)
-  "Search CANDIDATE-ITEMS for xacts that occur within the period today - EARLY  to today + HORIZON."
-  (let ((start-date (time-subtract (current-time) (days-to-time early)))
-        test-date items)
+  "Search CANDIDATE-ITEMS for xacts that occur within the period today - EARLY  to today + HORIZON.
+Candidates whose descriptors only name years outside the period
+are pruned up front instead of being evaluated for every day."
+  (let* ((start-date (time-subtract (current-time) (days-to-time early)))
+         (start-year (nth 5 (decode-time start-date)))
+         (end-year (nth 5 (decode-time (time-add start-date
+                                                 (days-to-time (+ early horizon))))))
+         (candidate-items
+          (cl-remove-if (lambda (candidate)
+                          (let ((years (nth 2 candidate)))
+                            (and years
+                                 (not (cl-find-if (lambda (year)
+                                                    (<= start-year year end-year))
+                                                  years)))))
+                        candidate-items))
+         test-date items)
     (cl-loop for day from 0 to (+ early horizon) by 1 do
              (setq test-date (time-add start-date (days-to-time day)))
              (dolist (candidate candidate-items items)
@@ -62,6 +62,51 @@
   "Return the actual date so the sort subroutine doesn't sort on the entire first line."
   (buffer-substring-no-properties (point) (+ 10 (point))))
 
+(defun ledger-sort--collect-xacts ()
+  "Collect the xacts in the narrowed region in one linear pass.
+Return a list of (KEY START . END) entries where KEY is the date
+prefix `ledger-sort-startkey' extracts and START and END delimit
+the xact text, excluding the separator after it."
+  (let (records)
+    (goto-char (point-min))
+    (while (not (eobp))
+      (let* ((start (point))
+             (key (ledger-sort-startkey))
+             (end (ledger-navigate-end-of-xact)))
+        (push (cons key (cons start end)) records)
+        (ledger-navigate-next-xact)))
+    (nreverse records)))
+
+(defun ledger-sort--reorder-xacts (records)
+  "Splice the xacts described by RECORDS back in date order.
+RECORDS is the list built by `ledger-sort--collect-xacts'.  The
+separators between xacts stay where they are; only the xact texts
+are permuted, and the buffer is rewritten with a single delete
+and insert so undo records just one change."
+  (let ((sorted (sort (copy-sequence records)
+                      (lambda (a b) (string< (car a) (car b)))))
+        (reporter (make-progress-reporter "Sorting ledger xacts..."
+                                          0 (length records)))
+        (count 0)
+        (last (point-min))
+        pieces)
+    (while records
+      (let ((old (cdar records))
+            (new (cdar sorted)))
+        ;; the separator leading up to this slot, then the xact
+        ;; that sorts into it
+        (push (buffer-substring last (car old)) pieces)
+        (push (buffer-substring (car new) (cdr new)) pieces)
+        (setq last (cdr old)
+              records (cdr records)
+              sorted (cdr sorted))
+        (progress-reporter-update reporter (setq count (1+ count)))))
+    (push (buffer-substring last (point-max)) pieces)
+    (let ((text (apply #'concat (nreverse pieces))))
+      (delete-region (point-min) (point-max))
+      (insert text))
+    (progress-reporter-done reporter)))
+
 (defun ledger-sort-region (beg end)
   "Sort the region from BEG to END in chronological order."
   (interactive "r") ;; load beg and end from point and mark
@@ -89,12 +134,10 @@
         (narrow-to-region new-beg new-end)
         (goto-char new-beg)
 
-        (let ((inhibit-field-text-motion t))
-          (sort-subr
-           nil
-           'ledger-navigate-next-xact
-           'ledger-navigate-end-of-xact
-           'ledger-sort-startkey))))
+        (let* ((inhibit-field-text-motion t)
+               (records (ledger-sort--collect-xacts)))
+          (when records
+            (ledger-sort--reorder-xacts records)))))
 
     (goto-char (point-min))
     (re-search-forward (regexp-quote target-xact))
@@ -231,28 +231,68 @@ dropped."
         (ledger-toggle-current-transaction style))
     (ledger-toggle-current-posting style)))
 
+(defun ledger-toggle--transaction-edit (&optional style)
+  "Compute the status-marker edit for the transaction line at point.
+Return a list (DEL-BEG DEL-END INSERTION STATUS) describing what
+`ledger-toggle-current-transaction' would do to the line, where
+STATUS is the state the transaction ends up in, or nil when point
+is not on a transaction first line.  STYLE is as for
+`ledger-toggle-current-transaction'."
+  (save-excursion
+    (beginning-of-line)
+    (when (looking-at "^[0-9]")
+      (skip-chars-forward "0-9./=\\-")
+      (let ((date-end (point))
+            (ws-end (progn (skip-chars-forward " \t") (point))))
+        (if (memq (ledger-state-from-char (char-after)) '(pending cleared))
+            (if (and style (eq style 'cleared))
+                (list date-end (1+ ws-end) " *" 'cleared)
+              (list date-end (1+ ws-end) "" nil))
+          (if (and style (eq style 'pending))
+              (list date-end ws-end " ! " 'pending)
+            (list date-end ws-end " * " 'cleared)))))))
+
+(defun ledger-toggle--apply-edit (edit)
+  "Apply EDIT, as returned by `ledger-toggle--transaction-edit'."
+  (delete-region (nth 0 edit) (nth 1 edit))
+  (goto-char (nth 0 edit))
+  (insert (nth 2 edit)))
+
 (defun ledger-toggle-current-transaction (&optional style)
   "Toggle the transaction at point using optional STYLE."
   (interactive)
   (save-excursion
     (when (or (looking-at "^[0-9]")
               (re-search-backward "^[0-9]" nil t))
-      (skip-chars-forward "0-9./=\\-")
-      (delete-horizontal-space)
-      (if (or (eq (ledger-state-from-char (char-after)) 'pending)
-              (eq (ledger-state-from-char (char-after)) 'cleared))
-          (progn
-            (delete-char 1)
-            (when (and style (eq style 'cleared))
-              (insert " *")
-              'cleared))
-        (if (and style (eq style 'pending))
-            (progn
-              (insert " ! ")
-              'pending)
-          (progn
-            (insert " * ")
-            'cleared))))))
+      (let ((edit (ledger-toggle--transaction-edit style)))
+        (when edit
+          (ledger-toggle--apply-edit edit)
+          (nth 3 edit))))))
+
+(defun ledger-toggle-region (begin end &optional style)
+  "Toggle the state of every transaction between BEGIN and END.
+This works at the transaction level, as
+`ledger-toggle-current-transaction' does, regardless of
+`ledger-clear-whole-transactions'.  The marker edits are
+collected in one scan and applied from the end of the region
+backwards, so bulk-clearing a month of imported transactions
+costs a single pass instead of one context re-parse per
+transaction.  Optional STYLE is `pending' or `cleared', as for
+`ledger-toggle-current'."
+  (interactive "r")
+  (save-excursion
+    (let (edits)
+      (goto-char begin)
+      (beginning-of-line)
+      (while (< (point) end)
+        (let ((edit (ledger-toggle--transaction-edit style)))
+          (when edit
+            (push edit edits)))
+        (forward-line 1))
+      ;; `edits' holds the most recent edit first; applying back to
+      ;; front keeps the earlier positions valid.
+      (dolist (edit edits)
+        (ledger-toggle--apply-edit edit)))))
 
 (provide 'ledger-state)
 
@@ -49,6 +49,15 @@ When nil, `ledger-add-transaction' will not prompt twice."
 
 (defvar-local ledger-xact-highlight-overlay (list))
 
+(defvar-local ledger-xact--highlight-extents nil
+  "Extents (BEGIN END) of the element last highlighted, or nil.
+Reused by `ledger-highlight-xact-under-point' while point stays
+inside them, so plain cursor motion does not re-search the
+buffer.")
+
+(defvar-local ledger-xact--highlight-tick nil
+  "Value of `buffer-chars-modified-tick' the cached extents are valid for.")
+
 (defun ledger-highlight-make-overlay ()
   (let ((ovl (make-overlay 1 1)))
     (overlay-put ovl 'font-lock-face 'ledger-font-xact-highlight-face)
@@ -60,10 +69,18 @@ When nil, `ledger-add-transaction' will not prompt twice."
   (when ledger-highlight-xact-under-point
     (unless ledger-xact-highlight-overlay
       (setq ledger-xact-highlight-overlay (ledger-highlight-make-overlay)))
-    (let ((exts (ledger-navigate-find-element-extents (point))))
+    (let* ((p (point))
+           (tick (buffer-chars-modified-tick))
+           (exts (if (and ledger-xact--highlight-extents
+                          (eq tick ledger-xact--highlight-tick)
+                          (>= p (car ledger-xact--highlight-extents))
+                          (<= p (cadr ledger-xact--highlight-extents)))
+                     ledger-xact--highlight-extents
+                   (setq ledger-xact--highlight-tick tick
+                         ledger-xact--highlight-extents
+                         (ledger-navigate-find-element-extents p)))))
       (let ((b (car exts))
-            (e (cadr exts))
-            (p (point)))
+            (e (cadr exts)))
         (if (and (> (- e b) 1)            ; not an empty line
                  (<= p e) (>= p b)        ; point is within the boundaries
                  (not (region-active-p))) ; no active region
@@ -101,9 +118,94 @@ When nil, `ledger-add-transaction' will not prompt twice."
       (and (= (car t1) (car t2))
            (< (nth 1 t1) (nth 1 t2)))))
 
+(defvar-local ledger-xact--date-cache nil
+  "Hash table from an xact start position to its encoded date.
+Filled lazily by `ledger-xact--date-at'.")
+
+(defvar-local ledger-xact--date-cache-tick nil
+  "Value of `buffer-chars-modified-tick' the date cache is valid for.")
+
+(defun ledger-xact--date-at (pos)
+  "Return the encoded date of the xact starting at POS, or nil.
+Parsed dates are cached until the buffer is edited."
+  (let ((tick (buffer-chars-modified-tick)))
+    (unless (and ledger-xact--date-cache
+                 (eq tick ledger-xact--date-cache-tick))
+      (setq ledger-xact--date-cache (make-hash-table :test #'eql)
+            ledger-xact--date-cache-tick tick)))
+  (let ((cached (gethash pos ledger-xact--date-cache 'miss)))
+    (if (not (eq cached 'miss))
+        cached
+      (puthash pos
+               (save-excursion
+                 (goto-char pos)
+                 (when (looking-at ledger-iso-date-regexp)
+                   (ledger-parse-iso-date (match-string 0))))
+               ledger-xact--date-cache))))
+
+(defun ledger-xact--start-before (pos limit)
+  "Return the start of the last xact beginning between LIMIT and POS.
+Return nil when there is none."
+  (save-excursion
+    (goto-char pos)
+    (end-of-line)
+    (when (re-search-backward "^[=~[:digit:]]" limit t)
+      (point))))
+
 (defun ledger-xact-find-slot (moment)
   "Find the right place in the buffer for a transaction at MOMENT.
-MOMENT is an encoded date"
+MOMENT is an encoded date.  Assuming the buffer is in
+chronological order, the slot is found by a binary search over
+buffer positions, so insertion cost does not grow with the size
+of the journal.  The search falls back to scanning from the
+beginning when MOMENT is not a time value, when the buffer uses
+year directives (which make a date's meaning depend on what
+precedes it), or when a probed transaction has no ISO date."
+  (unless (and (listp moment)
+               (not (save-excursion
+                      (goto-char (point-min))
+                      (re-search-forward "^\\(?:Y\\|year\\)\\>" nil t)))
+               (ledger-xact--find-slot-bisect moment))
+    (ledger-xact--find-slot-scan moment)))
+
+(defun ledger-xact--find-slot-bisect (moment)
+  "Binary search for the first xact dated after MOMENT.
+Leave point at the slot and return non-nil, or return nil when a
+probed xact has no parseable date."
+  (let ((lo (point-min))
+        (hi (point-max))
+        found)
+    (catch 'fallback
+      (while (< lo hi)
+        (let* ((mid (+ lo (/ (- hi lo) 2)))
+               (start (ledger-xact--start-before mid lo)))
+          (if (not start)
+              (setq lo (1+ mid))
+            (let ((date (ledger-xact--date-at start)))
+              (unless date
+                (throw 'fallback nil))
+              (if (ledger-time-less-p moment date)
+                  (setq hi start
+                        found t)
+                (setq lo (save-excursion
+                           (goto-char start)
+                           (forward-line)
+                           (point))))))))
+      (if found
+          (goto-char hi)
+        (goto-char (point-max))
+        (let ((last-xact-start (ledger-xact--start-before (point-max) (point-min))))
+          (when last-xact-start
+            (unless (ledger-xact--date-at last-xact-start)
+              (throw 'fallback nil))
+            (let ((end (cadr (ledger-navigate-find-xact-extents last-xact-start))))
+              (goto-char end)
+              (insert "\n")
+              (forward-line)))))
+      t)))
+
+(defun ledger-xact--find-slot-scan (moment)
+  "Find the slot for a transaction at MOMENT by scanning from the top."
   (let (last-xact-start)
     (catch 'found
       (ledger-xact-iterate-transactions
@@ -0,0 +1,179 @@
+;;; bench-helper.el --- Benchmark harness for ledger-mode  -*- lexical-binding: t; -*-
+
+;; Copyright (C) 2003-2017 John Wiegley <johnw AT gnu DOT org>
+
+;; Keywords: languages
+;; Homepage: https://github.com/ledger/ledger-mode
+
+;; This file is not part of GNU Emacs.
+
+;; This program is free software; you can redistribute it and/or modify it under
+;; the terms of the GNU General Public License as published by the Free Software
+;; Foundation; either version 2 of the License, or (at your option) any later
+;; version.
+;;
+;; This program is distributed in the hope that it will be useful, but WITHOUT
+;; ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+;; FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+;; details.
+;;
+;; You should have received a copy of the GNU General Public License along with
+;; this program; if not, write to the Free Software Foundation, Inc., 51
+;; Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+;;; Commentary:
+;;  Infrastructure for the benchmarks in bench-*.el: a synthetic
+;;  journal generator, wall time and GC accounting, and delta
+;;  reporting against a stored baseline.  Run with "make bench"
+;;  (optionally BENCH_COUNT=100000); record a baseline with
+;;  "make bench-baseline".
+
+;;; Code:
+(require 'ledger-mode)
+
+(defvar ledger-bench-journal-size 10000
+  "Number of transactions in the synthetic journal under test.
+Typical sizes are 10000, 100000 and 500000.")
+
+(defvar ledger-bench-all nil
+  "Benchmarks defined with `ledger-bench-define', in definition order.")
+
+(defvar ledger-bench-baseline-file
+  (expand-file-name "bench-baseline.eld"
+                    (file-name-directory (or load-file-name buffer-file-name)))
+  "File storing baseline results, keyed by benchmark and journal size.")
+
+(defun ledger-bench-generate-journal (count)
+  "Insert COUNT synthetic transactions into the current buffer.
+Dates are deliberately out of order, payees and accounts cycle
+through fixed pools, and every tenth transaction is uncleared."
+  (dotimes (i count)
+    (insert (format "%04d/%02d/%02d %sPayee%03d\n    Expenses:Category%02d  $%d.%02d\n    Assets:Checking\n\n"
+                    (+ 1990 (/ i 400))
+                    (1+ (mod (* i 5) 12))
+                    (1+ (mod (* i 13) 28))
+                    (if (zerop (mod i 10)) "" "* ")
+                    (mod i 97)
+                    (mod i 23)
+                    (1+ (mod i 500))
+                    (mod i 100)))))
+
+(defmacro ledger-bench-with-journal (&rest body)
+  "Evaluate BODY in a `ledger-mode' buffer holding a synthetic journal.
+The journal has `ledger-bench-journal-size' transactions and
+point starts at the beginning of the buffer."
+  (declare (indent 0) (debug t))
+  `(with-temp-buffer
+     (ledger-bench-generate-journal ledger-bench-journal-size)
+     (ledger-mode)
+     (goto-char (point-min))
+     ,@body))
+
+(defmacro ledger-bench-measure (&rest body)
+  "Evaluate BODY and return its wall time and GC accounting.
+The result is a plist with :time (seconds), :gcs (collections
+run) and :gc-time (seconds spent collecting).  A collection is
+forced first so BODY does not pay for garbage left by setup."
+  (declare (indent 0) (debug t))
+  `(progn
+     (garbage-collect)
+     (let ((bench-start (current-time))
+           (bench-gcs gcs-done)
+           (bench-gc-time gc-elapsed))
+       ,@body
+       (list :time (float-time (time-subtract (current-time) bench-start))
+             :gcs (- gcs-done bench-gcs)
+             :gc-time (- gc-elapsed bench-gc-time)))))
+
+(defmacro ledger-bench-define (name docstring &rest body)
+  "Define benchmark NAME with DOCSTRING.
+BODY should set up its own journal (see
+`ledger-bench-with-journal') and return the plist produced by
+`ledger-bench-measure' around the code under test, or nil to
+report the benchmark as skipped."
+  (declare (indent 1) (doc-string 2) (debug (symbolp stringp body)))
+  `(progn
+     (put ',name 'ledger-bench-doc ,docstring)
+     (put ',name 'ledger-bench-fn (lambda () ,@body))
+     (unless (memq ',name ledger-bench-all)
+       (setq ledger-bench-all (append ledger-bench-all (list ',name))))
+     ',name))
+
+(defun ledger-bench--read-baseline ()
+  "Return the stored baseline alist, or nil when none exists."
+  (when (file-readable-p ledger-bench-baseline-file)
+    (condition-case nil
+        (with-temp-buffer
+          (insert-file-contents ledger-bench-baseline-file)
+          (read (current-buffer)))
+      (error nil))))
+
+(defun ledger-bench--baseline-key (name)
+  "Return the baseline key for benchmark NAME at the current size."
+  (cons name ledger-bench-journal-size))
+
+(defun ledger-bench--report (name result baseline)
+  "Print one line for benchmark NAME with RESULT, compared to BASELINE."
+  (if (not result)
+      (princ (format "%-32s     skipped\n" name))
+    (princ (format "%-32s %9.3fs  %4d GCs %7.3fs in GC%s\n"
+                   name
+                   (plist-get result :time)
+                   (plist-get result :gcs)
+                   (plist-get result :gc-time)
+                   (if baseline
+                       (format "  %+6.1f%% vs baseline"
+                               (* 100 (/ (- (plist-get result :time)
+                                            (plist-get baseline :time))
+                                         (plist-get baseline :time))))
+                     "")))))
+
+(defun ledger-bench-run ()
+  "Run every defined benchmark and report deltas against the baseline.
+Return an alist mapping benchmark names to result plists."
+  (let ((baseline (ledger-bench--read-baseline))
+        results)
+    (princ (format "ledger-mode benchmarks, %d transactions\n\n"
+                   ledger-bench-journal-size))
+    (dolist (name ledger-bench-all)
+      (let ((result (funcall (get name 'ledger-bench-fn))))
+        (push (cons name result) results)
+        (ledger-bench--report name result
+                              (cdr (assoc (ledger-bench--baseline-key name)
+                                          baseline)))))
+    (nreverse results)))
+
+(defun ledger-bench-write-baseline ()
+  "Run every benchmark and store the results as the new baseline.
+Existing baseline entries for other journal sizes are kept."
+  (let ((baseline (ledger-bench--read-baseline)))
+    (dolist (entry (ledger-bench-run))
+      (when (cdr entry)
+        (let* ((key (ledger-bench--baseline-key (car entry)))
+               (old (assoc key baseline)))
+          (if old
+              (setcdr old (cdr entry))
+            (push (cons key (cdr entry)) baseline)))))
+    (with-temp-file ledger-bench-baseline-file
+      (let ((print-length nil)
+            (print-level nil))
+        (prin1 baseline (current-buffer))))
+    (princ (format "\nBaseline written to %s\n" ledger-bench-baseline-file))))
+
+(defun ledger-bench-run-and-exit (&optional count)
+  "Run the benchmarks with COUNT transactions and exit Emacs."
+  (when count
+    (setq ledger-bench-journal-size count))
+  (ledger-bench-run)
+  (kill-emacs 0))
+
+(defun ledger-bench-save-baseline-and-exit (&optional count)
+  "Store a baseline with COUNT transactions and exit Emacs."
+  (when count
+    (setq ledger-bench-journal-size count))
+  (ledger-bench-write-baseline)
+  (kill-emacs 0))
+
+(provide 'bench-helper)
+
+;;; bench-helper.el ends here
@@ -0,0 +1,78 @@
+;;; bench-ledger.el --- Benchmarks for ledger-mode hot paths  -*- lexical-binding: t; -*-
+
+;; Copyright (C) 2003-2017 John Wiegley <johnw AT gnu DOT org>
+
+;; Keywords: languages
+;; Homepage: https://github.com/ledger/ledger-mode
+
+;; This file is not part of GNU Emacs.
+
+;; This program is free software; you can redistribute it and/or modify it under
+;; the terms of the GNU General Public License as published by the Free Software
+;; Foundation; either version 2 of the License, or (at your option) any later
+;; version.
+;;
+;; This program is distributed in the hope that it will be useful, but WITHOUT
+;; ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+;; FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+;; details.
+;;
+;; You should have received a copy of the GNU General Public License along with
+;; this program; if not, write to the Free Software Foundation, Inc., 51
+;; Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+
+;;; Commentary:
+;;  Benchmarks for the interactive hot paths that have regressed in
+;;  the past: completion, occur narrowing, sorting, alignment and the
+;;  reconcile listing.  See bench-helper.el for the harness.
+
+;;; Code:
+(require 'bench-helper)
+(require 'ledger-complete)
+(require 'ledger-occur)
+(require 'ledger-sort)
+(require 'ledger-post)
+(require 'ledger-reconcile)
+(require 'ledger-exec)
+
+(ledger-bench-define ledger-bench-complete-account
+  "Account completion at the end of the journal, including index build."
+  (ledger-bench-with-journal
+    (goto-char (point-max))
+    (insert "2050/01/01 Payee001\n    Ex")
+    (ledger-bench-measure
+      (let ((data (ledger-complete-at-point)))
+        (all-completions "" (nth 2 data))))))
+
+(ledger-bench-define ledger-bench-occur
+  "Narrowing the buffer to one payee with `ledger-occur'."
+  (ledger-bench-with-journal
+    (ledger-bench-measure
+      (ledger-occur "Payee042"))))
+
+(ledger-bench-define ledger-bench-sort-buffer
+  "Sorting the whole journal by date."
+  (ledger-bench-with-journal
+    (ledger-bench-measure
+      (ledger-sort-buffer))))
+
+(ledger-bench-define ledger-bench-align-postings
+  "Aligning every posting in the journal."
+  (ledger-bench-with-journal
+    (ledger-bench-measure
+      (ledger-post-align-postings (point-min) (point-max)))))
+
+(ledger-bench-define ledger-bench-do-reconcile
+  "Building the reconcile listing.  Needs the ledger binary."
+  (when (executable-find ledger-binary-path)
+    (ledger-bench-with-journal
+      (let ((buf (current-buffer)))
+        (with-temp-buffer
+          (let ((ledger-buf buf)
+                (ledger-acct "Assets:Checking"))
+            (ledger-bench-measure
+              (ledger-do-reconcile ledger-reconcile-sort-key))))))))
+
+(provide 'bench-ledger)
+
+;;; bench-ledger.el ends here
@@ -280,6 +280,33 @@ account Assets:Checking:Bank B")
 2020-04-01 Fnord
     Assets:")))))
 
+(ert-deftest ledger-complete/test-incremental-index ()
+  "The payee index tracks insertions and deletions of transactions."
+  :tags '(complete baseline)
+  (ledger-tests-with-temp-file
+      "2011/01/02 Grocery Store
+    Expenses:Food:Groceries             $ 65.00
+    Assets:Checking
+
+2011/01/05 Employer
+    Assets:Checking                 $ 2000.00
+    Income:Salary
+"
+    (should (equal (ledger-payees-in-buffer)
+                   '("Employer" "Grocery Store")))
+    (goto-char (point-max))
+    (let ((beg (point)))
+      (insert "\n2011/02/01 Book Store
+    Expenses:Books                       $20.00
+    Assets:Checking
+")
+      (goto-char (point-min))
+      (should (equal (ledger-payees-in-buffer)
+                     '("Book Store" "Employer" "Grocery Store")))
+      (delete-region beg (point-max))
+      (should (equal (ledger-payees-in-buffer)
+                     '("Employer" "Grocery Store"))))))
+
 (provide 'complete-test)
 
 ;;; complete-test.el ends here
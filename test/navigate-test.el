@@ -68,6 +68,39 @@ http://bugs.ledger-cli.org/show_bug.cgi?id=441"
    (should (bobp))))
 
 
+(ert-deftest ledger-navigate-uncleared-index-tracks-edits ()
+  "The uncleared-position index stays consistent while the buffer is edited."
+  :tags '(navigate baseline)
+  (ledger-tests-with-temp-file
+   "2011/01/27 * Book Store
+    Expenses:Books                       $20.00
+    Liabilities:MasterCard
+
+2011/04/27 Bookstore
+    Expenses:Books                       $20.00
+    Assets:Checking
+
+2011/12/01 * Sale
+    Assets:Checking                     $ 30.00
+    Income:Sales
+"
+   ;; Build the index, then clear the transaction it found.
+   (ledger-navigate-next-uncleared)
+   (should (looking-at-p "2011/04/27 Bookstore"))
+   (ledger-toggle-current-transaction)
+   (goto-char (point-min))
+   (should-error (ledger-navigate-next-uncleared))
+   ;; A newly inserted uncleared transaction is picked up.
+   (goto-char (point-max))
+   (insert "\n2012/01/05 New Shop
+    Expenses:Misc                         $1.00
+    Assets:Checking
+")
+   (goto-char (point-min))
+   (ledger-navigate-next-uncleared)
+   (should (looking-at-p "2012/01/05 New Shop"))))
+
+
 (provide 'navigate-test)
 
 ;;; navigate-test.el ends here
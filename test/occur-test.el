@@ -52,6 +52,54 @@ http://bugs.ledger-cli.org/show_bug.cgi?id=246"
 "))))
 
 
+(ert-deftest ledger-occur/test-occur-files ()
+  "`ledger-occur-files' aggregates matches across the include graph."
+  :tags '(occur baseline)
+  (let* ((child (make-temp-file "ledger-occur-child" nil ".ledger"
+                                "2011/01/02 Grocery Store
+    Expenses:Food:Groceries             $ 65.00
+    Assets:Checking
+"))
+         (master (make-temp-file "ledger-occur-master" nil ".ledger"
+                                 (concat "include " child "
+
+2011/01/05 Grocery Store
+    Expenses:Food:Groceries              $ 5.00
+    Assets:Checking
+
+2011/01/07 Hardware Store
+    Expenses:Tools                      $ 15.00
+    Assets:Checking
+")))
+         (buf (find-file-noselect master)))
+    (unwind-protect
+        (progn
+          (with-current-buffer buf
+            (ledger-mode)
+            (ledger-occur-files "Grocery Store"))
+          ;; Drive the timer-driven file steps synchronously.
+          (while ledger-occur-files--timer
+            (cancel-timer ledger-occur-files--timer)
+            (setq ledger-occur-files--timer nil)
+            (ledger-occur-files--step))
+          (with-current-buffer ledger-occur-files-buffer-name
+            (should (= 2 ledger-occur-files--match-count))
+            ;; Master is searched first; its match is on line 3 and
+            ;; carries the jump property reused from report buffers.
+            (let ((pos (next-single-property-change (point-min) 'ledger-source)))
+              (should pos)
+              (should (equal (get-text-property pos 'ledger-source)
+                             (cons (expand-file-name master) 3))))
+            (goto-char (point-min))
+            (should (search-forward (file-name-nondirectory child) nil t))
+            (should-not (search-forward "Hardware Store" nil t))))
+      (when (get-buffer ledger-occur-files-buffer-name)
+        (kill-buffer ledger-occur-files-buffer-name))
+      (kill-buffer buf)
+      (delete-file master)
+      (delete-file child))))
+
+
 (provide 'occur-test)
 
 ;;; occur-test.el ends here
@@ -735,6 +735,71 @@ http://bugs.ledger-cli.org/show_bug.cgi?id=262"
        (eq (1- line-before-delete) (line-number-at-pos))))))
 
 
+(ert-deftest ledger-reconcile/test-amount-index ()
+  "The amount index groups listing lines by absolute amount value."
+  :tags '(reconcile baseline)
+
+  (with-temp-buffer
+    (dolist (spec '(("11/16      one   $20.00" ledger-font-reconciler-uncleared-face "$20.00")
+                    ("11/17      two   $10.00" ledger-font-reconciler-cleared-face "$10.00")
+                    ("11/18    three  $-20.00" ledger-font-reconciler-uncleared-face "$-20.00")))
+      (let ((beg (point)))
+        (insert (nth 0 spec) "\n")
+        (set-text-properties beg (1- (point))
+                             (list 'where (cons (current-buffer) 1)
+                                   'font-lock-face (nth 1 spec)
+                                   'amount (nth 2 spec)))))
+    (let ((index (ledger-reconcile--ensure-amount-index)))
+      (should (= 2 (length (gethash 20.0 index))))
+      (should (= 1 (length (gethash 10.0 index))))
+      (should-not (gethash 30.0 index)))))
+
+
+(ert-deftest ledger-reconcile/test-input-amount ()
+  "Amounts are recovered from bare values and pasted statement lines."
+  :tags '(reconcile baseline)
+
+  (should (= 20.0 (ledger-reconcile--input-amount "20.00")))
+  (should (= -20.0 (ledger-reconcile--input-amount "CARD PAYMENT -20.00")))
+  (should (= 43.21 (ledger-reconcile--input-amount "08/12 AMAZON.COM 43.21")))
+  (should-not (ledger-reconcile--input-amount "no amount here")))
+
+
+(ert-deftest ledger-reconcile/test-find-amount ()
+  "`ledger-reconcile-find-amount' prefers uncleared matches and cycles."
+  :tags '(reconcile baseline)
+
+  (with-temp-buffer
+    (let (line2 line3)
+      (insert (propertize "11/16      one   $20.00"
+                          'where (cons (current-buffer) 1)
+                          'font-lock-face 'ledger-font-reconciler-uncleared-face
+                          'amount "$20.00")
+              "\n")
+      (setq line2 (point))
+      (insert (propertize "11/17      two   $10.00"
+                          'where (cons (current-buffer) 1)
+                          'font-lock-face 'ledger-font-reconciler-cleared-face
+                          'amount "$10.00")
+              "\n")
+      (setq line3 (point))
+      (insert (propertize "11/18    three   $20.00"
+                          'where (cons (current-buffer) 1)
+                          'font-lock-face 'ledger-font-reconciler-uncleared-face
+                          'amount "$20.00")
+              "\n")
+      (goto-char (point-min))
+      ;; From the first match, jump to the next one, then wrap around.
+      (ledger-reconcile-find-amount "20.00")
+      (should (= (point) line3))
+      (ledger-reconcile-find-amount "20.00")
+      (should (= (point) (point-min)))
+      ;; A match that is already marked is still reachable.
+      (ledger-reconcile-find-amount "10.00")
+      (should (= (point) line2))
+      (should-error (ledger-reconcile-find-amount "99.99")))))
+
+
 (provide 'reconcile-test)
 
 ;;; reconcile-test.el ends here
@@ -274,6 +274,18 @@ In particular, the group count and index variables should match EXPECTED."
      (ledger-regex-xact-line-group-note 11)
      (ledger-regex-xact-line-group-state 9))))
 
+(ert-deftest ledger-regex/test-loads-cleanly ()
+  "The load-time group-count check must not reject the shipped patterns."
+  (should (load "ledger-regex" nil t)))
+
+(ert-deftest ledger-regex/test-group-count ()
+  "`ledger-regex--group-count' counts numbered groups, unlike `regexp-opt-depth'."
+  (should (= 0 (ledger-regex--group-count "a\\(?:b\\)c")))
+  (should (= 1 (ledger-regex--group-count "\\(a\\)")))
+  (should (= 1 (ledger-regex--group-count "\\(?1:a\\)")))
+  (should (= 2 (ledger-regex--group-count "\\(?1:a\\(?: \\)*\\)\\(b\\)")))
+  (should (= 1 (ledger-regex--group-count ledger-account-any-status-regex))))
+
 (provide 'regex-test)
 
 ;;; regex-test.el ends here
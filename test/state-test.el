@@ -56,6 +56,61 @@ http://bugs.ledger-cli.org/show_bug.cgi?id=1030"
 " ))))
 
 
+(ert-deftest ledger-state/test-toggle-region ()
+  "`ledger-toggle-region' toggles every transaction in the region at once."
+  :tags '(state baseline)
+
+  (ledger-tests-with-temp-file
+"2013/06/09 4 Saisons
+    Dépense:Alimentation:Restaurant          23,00 €
+    Passif:Crédit:BanqueAccord
+
+2013/06/15 Marché
+    Dépense:Alimentation                     12,00 €
+    Actif:Courant
+"
+    (ledger-toggle-region (point-min) (point-max))
+    (should
+     (equal (buffer-string)
+      "2013/06/09 * 4 Saisons
+    Dépense:Alimentation:Restaurant          23,00 €
+    Passif:Crédit:BanqueAccord
+
+2013/06/15 * Marché
+    Dépense:Alimentation                     12,00 €
+    Actif:Courant
+" ))
+    (ledger-toggle-region (point-min) (point-max))
+    (should
+     (equal (buffer-string)
+      "2013/06/09 4 Saisons
+    Dépense:Alimentation:Restaurant          23,00 €
+    Passif:Crédit:BanqueAccord
+
+2013/06/15 Marché
+    Dépense:Alimentation                     12,00 €
+    Actif:Courant
+" ))))
+
+
+(ert-deftest ledger-state/test-toggle-region-pending ()
+  "`ledger-toggle-region' honors the pending STYLE."
+  :tags '(state baseline)
+
+  (ledger-tests-with-temp-file
+"2013/06/09 4 Saisons
+    Dépense:Alimentation:Restaurant          23,00 €
+    Passif:Crédit:BanqueAccord
+"
+    (ledger-toggle-region (point-min) (point-max) 'pending)
+    (should
+     (equal (buffer-string)
+      "2013/06/09 ! 4 Saisons
+    Dépense:Alimentation:Restaurant          23,00 €
+    Passif:Crédit:BanqueAccord
+" ))))
+
+
 (provide 'state-test)
 
 ;;; state-test.el ends here
@@ -126,6 +126,50 @@ https://github.com/ledger/ledger-mode/issues/307"
     Assets:Bar
 "))))
 
+(ert-deftest ledger-xact/test-find-slot-bisect ()
+  "`ledger-xact-find-slot' bisects to the right chronological slot."
+  :tags '(xact baseline)
+
+  (ledger-tests-with-temp-file
+      "2013/05/01 alpha
+    Expenses:Foo                            $10.00
+    Assets:Bar
+
+2013/05/03 beta
+    Expenses:Foo                            $10.00
+    Assets:Bar
+
+2013/05/05 gamma
+    Expenses:Foo                            $10.00
+    Assets:Bar
+"
+    (ledger-xact-find-slot (ledger-parse-iso-date "2013/05/04"))
+    (should (looking-at-p "2013/05/05 gamma"))
+    (ledger-xact-find-slot (ledger-parse-iso-date "2013/05/02"))
+    (should (looking-at-p "2013/05/03 beta"))
+    (ledger-xact-find-slot (ledger-parse-iso-date "2013/04/30"))
+    (should (bobp))))
+
+
+(ert-deftest ledger-xact/test-find-slot-year-directive ()
+  "A year directive forces the scanning fallback, which still finds the slot."
+  :tags '(xact baseline)
+
+  (ledger-tests-with-temp-file
+      "year 2013
+
+2013/05/01 alpha
+    Expenses:Foo                            $10.00
+    Assets:Bar
+
+2013/05/05 gamma
+    Expenses:Foo                            $10.00
+    Assets:Bar
+"
+    (ledger-xact-find-slot (ledger-parse-iso-date "2013/05/02"))
+    (should (looking-at-p "2013/05/05 gamma"))))
+
+
 (provide 'xact-test)
 
 ;;; xact-test.el ends here